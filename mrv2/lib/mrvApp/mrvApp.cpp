@@ -31,6 +31,8 @@ namespace py = pybind11;
 #include "mrvFl/mrvContextObject.h"
 #include "mrvFl/mrvLanguages.h"
 #include "mrvFl/mrvPreferences.h"
+#include "mrvFl/mrvSave.h"
+#include "mrvFl/mrvScheduler.h"
 #include "mrvFl/mrvSession.h"
 #include "mrvFl/mrvTimelinePlayer.h"
 
@@ -69,6 +71,7 @@ namespace py = pybind11;
 #include "mrvApp/mrvFilesModel.h"
 #include "mrvApp/mrvMainControl.h"
 #include "mrvApp/mrvOpenSeparateAudioDialog.h"
+#include "mrvApp/mrvPlayerPool.h"
 #include "mrvApp/mrvSettingsObject.h"
 
 #include "mrvPreferencesUI.h"
@@ -151,6 +154,10 @@ namespace mrv
         timeline::OCIOOptions ocioOptions;
         timeline::LUTOptions lutOptions;
 
+        std::string renderFileName;
+        int renderScale = 1;
+        SaveOptions saveOptions;
+
         bool hud = true;
         bool resetSettings = false;
         bool resetHotkeys = false;
@@ -212,6 +219,9 @@ namespace mrv
 
         std::shared_ptr<TimelinePlayer> player;
 
+        //! Players of the previous A files.
+        PlayerPool playerPool;
+
         MainControl* mainControl = nullptr;
 
         bool session = false;
@@ -363,6 +373,49 @@ namespace mrv
                         _("LUT operation order."),
                         string::Format("{0}").arg(p.options.lutOptions.order),
                         string::join(timeline::getLUTOrderLabels(), ", ")),
+                    app::CmdLineValueOption<std::string>::create(
+                        p.options.renderFileName, {"-render", "-bake"},
+                        _("Render the inputs to a movie or image sequence "
+                          "without opening the viewer, and exit.")),
+                    app::CmdLineValueOption<int>::create(
+                        p.options.renderScale, {"-renderScale"},
+                        _("Divide the size of the render by 1, 2 or 4."),
+                        string::Format("{0}").arg(p.options.renderScale)),
+#ifdef TLRENDER_FFMPEG
+                    app::CmdLineValueOption<ffmpeg::Profile>::create(
+                        p.options.saveOptions.ffmpegProfile,
+                        {"-renderProfile"}, _("FFmpeg profile of the render."),
+                        string::Format("{0}").arg(
+                            p.options.saveOptions.ffmpegProfile),
+                        string::join(ffmpeg::getProfileLabels(), ", ")),
+                    app::CmdLineValueOption<std::string>::create(
+                        p.options.saveOptions.ffmpegPixelFormat,
+                        {"-renderPixelFormat"},
+                        _("FFmpeg pixel format of the render."),
+                        p.options.saveOptions.ffmpegPixelFormat),
+                    app::CmdLineValueOption<ffmpeg::AudioCodec>::create(
+                        p.options.saveOptions.ffmpegAudioCodec,
+                        {"-renderAudioCodec"},
+                        _("FFmpeg audio codec of the render."),
+                        string::Format("{0}").arg(
+                            p.options.saveOptions.ffmpegAudioCodec),
+                        string::join(ffmpeg::getAudioCodecLabels(), ", ")),
+#endif
+#ifdef TLRENDER_EXR
+                    app::CmdLineValueOption<exr::Compression>::create(
+                        p.options.saveOptions.exrCompression,
+                        {"-renderCompression"},
+                        _("OpenEXR compression of the render."),
+                        string::Format("{0}").arg(
+                            p.options.saveOptions.exrCompression),
+                        string::join(exr::getCompressionLabels(), ", ")),
+                    app::CmdLineValueOption<image::PixelType>::create(
+                        p.options.saveOptions.exrPixelType,
+                        {"-renderPixelType"},
+                        _("OpenEXR pixel type of the render."),
+                        string::Format("{0}").arg(
+                            p.options.saveOptions.exrPixelType)),
+#endif
 #ifdef MRV2_PYBIND11
                     app::CmdLineValueOption<std::string>::create(
                         p.options.pythonScript, {"-pythonScript", "-ps"},
@@ -480,6 +533,50 @@ namespace mrv
             return;
         }
 
+        // Render without creating the interface, the settings or the
+        // python plug-ins.
+        if (!p.options.renderFileName.empty())
+        {
+            if (p.options.fileNames.empty())
+            {
+                std::cerr << _("No input to render.") << std::endl;
+                _exit = 1;
+                return;
+            }
+
+            RenderOptions renderOptions;
+            renderOptions.audioFileName = p.options.audioFileName;
+            renderOptions.inOutRange = p.options.inOutRange;
+            renderOptions.ocioOptions = p.options.ocioOptions;
+            renderOptions.lutOptions = p.options.lutOptions;
+            renderOptions.saveOptions = p.options.saveOptions;
+            switch (p.options.renderScale)
+            {
+            case 1:
+                break;
+            case 2:
+                renderOptions.saveOptions.resolution =
+                    SaveResolution::kHalfSize;
+                break;
+            case 4:
+                renderOptions.saveOptions.resolution =
+                    SaveResolution::kQuarterSize;
+                break;
+            default:
+                std::cerr << string::Format(_("Invalid render scale {0}.  "
+                                              "Use 1, 2 or 4."))
+                                 .arg(p.options.renderScale)
+                          << std::endl;
+                _exit = 1;
+                return;
+            }
+
+            _exit = render_movie(
+                p.options.fileNames[0], p.options.renderFileName, context,
+                renderOptions);
+            return;
+        }
+
         // Initialize FLTK.
         Fl::scheme("gtk+");
         Fl::option(Fl::OPTION_VISIBLE_FOCUS, false);
@@ -520,6 +617,8 @@ namespace mrv
 #endif
         ui->uiView->setContext(context);
 
+        // Slow down the timers of the main loop when idle.
+        scheduler::init();
         p.contextObject = new mrv::ContextObject(context);
         p.timeUnitsModel = timeline::TimeUnitsModel::create(context);
         p.filesModel = FilesModel::create(context);
@@ -918,6 +1017,8 @@ namespace mrv
         delete p.mainControl;
         p.mainControl = nullptr;
 
+        p.playerPool.clear();
+
 #ifdef MRV2_NETWORK
         delete p.commandInterpreter;
         p.commandInterpreter = nullptr;
@@ -966,6 +1067,15 @@ namespace mrv
         return _p->playlistsModel;
     }
 
+    CommandInterpreter* App::commandInterpreter() const
+    {
+#ifdef MRV2_NETWORK
+        return _p->commandInterpreter;
+#else
+        return nullptr;
+#endif
+    }
+
     const timeline::LUTOptions& App::lutOptions() const
     {
         return _p->lutOptions;
@@ -1402,6 +1512,7 @@ namespace mrv
 
         p.files = files;
         p.timelines = timelines;
+        p.playerPool.prune(files);
 
         panel::refreshThumbnails();
     }
@@ -1528,10 +1639,14 @@ namespace mrv
                         auto timeline = p.timelines[idx];
                         if (!timeline)
                             return;
-                        player.reset(new TimelinePlayer(
-                            timeline::Player::create(
-                                timeline, _context, playerOptions),
-                            _context));
+                        player = p.playerPool.take(item, timeline);
+                        if (!player)
+                        {
+                            player.reset(new TimelinePlayer(
+                                timeline::Player::create(
+                                    timeline, _context, playerOptions),
+                                _context));
+                        }
 
                         item->timeRange = player->timeRange();
                         item->ioInfo = player->ioInfo();
@@ -1642,6 +1757,20 @@ namespace mrv
                 view->frameView();
         }
 
+        // Keep the player of the previous A file, so switching back to it
+        // reuses its cache.
+        if (p.player && p.player != player && !p.activeFiles.empty())
+        {
+            const auto& item = p.activeFiles[0];
+            if (std::find(p.files.begin(), p.files.end(), item) !=
+                    p.files.end() &&
+                !file::isTemporaryEDL(item->path) &&
+                !file::isTemporaryNDI(item->path))
+            {
+                p.playerPool.park(item, p.player);
+            }
+        }
+
         p.activeFiles = activeFiles;
         p.player = player;
 
@@ -1774,6 +1903,11 @@ namespace mrv
             Gbytes = 4;
         }
 
+        // When the cache is not sized in bytes, the players of the previous
+        // A files get no memory of their own.
+        if (Gbytes == 0)
+            p.playerPool.setMaxBytes(0);
+
         if (Gbytes > 0)
         {
             // Do some sanity checking in case the user is using several mrv2
@@ -1793,6 +1927,12 @@ namespace mrv
 
             uint64_t bytes = Gbytes * memory::gigabyte;
 
+            // The players of the previous A files share a quarter of the
+            // cache.
+            p.playerPool.setMaxBytes(bytes / 4);
+            const uint64_t playerBytes =
+                p.playerPool.isEmpty() ? bytes : bytes - bytes / 4;
+
             // Update the I/O cache.
             auto ioSystem = _context->getSystem<io::System>();
             ioSystem->getCache()->setMax(bytes);
@@ -1810,7 +1950,7 @@ namespace mrv
                 {
                     const auto& video = ioInfo.video[0];
                     std::size_t size = tl::image::getDataByteCount(video);
-                    double frames = bytes / static_cast<double>(size);
+                    double frames = playerBytes / static_cast<double>(size);
                     seconds = frames / p.player->defaultSpeed();
                 }
 
@@ -1843,9 +1983,34 @@ namespace mrv
                 options.readAhead = otime::RationalTime(readAhead, 1.0);
                 options.readBehind = otime::RationalTime(readBehind, 1.0);
             }
+            else if (!p.playerPool.isEmpty() && !ioInfo.video.empty())
+            {
+                // Movies keep the read ahead and behind of the preferences,
+                // but only as much of them as fits in the share of the A
+                // player, as the parked players use the rest.
+                const auto& video = ioInfo.video[0];
+                const std::size_t size = tl::image::getDataByteCount(video);
+                const double total = options.readAhead.to_seconds() +
+                                     options.readBehind.to_seconds();
+                if (size > 0 && total > 0.0)
+                {
+                    const double frames =
+                        playerBytes / static_cast<double>(size);
+                    const double seconds = frames / p.player->defaultSpeed();
+                    if (seconds < total)
+                    {
+                        const double scale = seconds / total;
+                        options.readAhead = otime::RationalTime(
+                            options.readAhead.to_seconds() * scale, 1.0);
+                        options.readBehind = otime::RationalTime(
+                            options.readBehind.to_seconds() * scale, 1.0);
+                    }
+                }
+            }
         }
 
         p.player->setCacheOptions(options);
+        p.playerPool.trim();
     }
 
     void App::_audioUpdate()
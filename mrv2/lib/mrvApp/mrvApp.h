@@ -25,6 +25,7 @@ namespace mrv
 {
     using namespace tl;
 
+    class CommandInterpreter;
     class OutputDevice;
 
     struct Playlist;
@@ -75,6 +76,9 @@ namespace mrv
         //! Get the devices model.
         const std::shared_ptr<DevicesModel>& devicesModel() const;
 
+        //! Get the network command interpreter.
+        CommandInterpreter* commandInterpreter() const;
+
         //! Create a new application.
         static std::shared_ptr<App>
         create(int argc, char* argv[], const std::shared_ptr<system::Context>&);
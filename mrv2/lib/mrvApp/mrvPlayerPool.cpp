@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <list>
+
+#include <tlCore/Image.h>
+#include <tlCore/Memory.h>
+
+#include <FL/Fl.H>
+
+#include "mrvCore/mrvI8N.h"
+#include "mrvCore/mrvMemory.h"
+
+#include "mrvFl/mrvIO.h"
+
+#include "mrvApp/mrvFilesModel.h"
+#include "mrvApp/mrvPlayerPool.h"
+
+namespace
+{
+    const char* kModule = "pool";
+
+    //! Most players kept besides the one of the A file.
+    const size_t kMaxPlayers = 4;
+
+    //! Fraction of the physical memory mrv2 can use before players are
+    //! destroyed.
+    const double kMaxMemoryFraction = 0.75;
+
+    //! Seconds between checks of the memory used while players are parked.
+    const double kTimeout = 1.0;
+} // namespace
+
+namespace mrv
+{
+    struct PlayerPool::Private
+    {
+        struct Entry
+        {
+            std::shared_ptr<FilesModelItem> item;
+            std::shared_ptr<TimelinePlayer> player;
+
+            //! Memory the cache of the player may use.
+            uint64_t bytes = 0;
+        };
+
+        //! Parked players, most recently used first.
+        std::list<Entry> entries;
+
+        uint64_t maxBytes = 0;
+    };
+
+    PlayerPool::PlayerPool() :
+        _p(new Private)
+    {
+    }
+
+    PlayerPool::~PlayerPool()
+    {
+        Fl::remove_timeout((Fl_Timeout_Handler)timerEvent_cb, this);
+    }
+
+    void PlayerPool::setMaxBytes(const uint64_t value)
+    {
+        TLRENDER_P();
+        if (value == p.maxBytes)
+            return;
+        p.maxBytes = value;
+        for (auto& entry : p.entries)
+            entry.bytes = _setCacheOptions(entry.player);
+        trim();
+    }
+
+    void PlayerPool::park(
+        const std::shared_ptr<FilesModelItem>& item,
+        const std::shared_ptr<TimelinePlayer>& player)
+    {
+        TLRENDER_P();
+        if (!item || !player)
+            return;
+
+        // The player no longer updates the user interface, and it is
+        // stopped through the tlRender player, as the TimelinePlayer
+        // methods send playback changes to the network.
+        player->setObserving(false);
+        player->setTimelineViewport(nullptr);
+        auto innerPlayer = player->player();
+        innerPlayer->setPlayback(timeline::Playback::Stop);
+        innerPlayer->setMute(true);
+        innerPlayer->setCompare({});
+        const uint64_t bytes = _setCacheOptions(player);
+
+        p.entries.remove_if([&item](const Private::Entry& entry)
+                            { return entry.item == item; });
+        p.entries.push_front({item, player, bytes});
+        trim();
+
+        // Memory can run low while the A file plays, not only when a
+        // player is parked.
+        if (!p.entries.empty() &&
+            !Fl::has_timeout((Fl_Timeout_Handler)timerEvent_cb, this))
+        {
+            Fl::add_timeout(
+                kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
+        }
+    }
+
+    std::shared_ptr<TimelinePlayer> PlayerPool::take(
+        const std::shared_ptr<FilesModelItem>& item,
+        const std::shared_ptr<timeline::Timeline>& timeline)
+    {
+        TLRENDER_P();
+        std::shared_ptr<TimelinePlayer> out;
+        for (auto i = p.entries.begin(); i != p.entries.end(); ++i)
+        {
+            if (i->item != item)
+                continue;
+            if (i->player->timeline() == timeline)
+            {
+                out = i->player;
+                out->setObserving(true);
+            }
+            p.entries.erase(i);
+            break;
+        }
+        return out;
+    }
+
+    void PlayerPool::prune(
+        const std::vector<std::shared_ptr<FilesModelItem> >& files)
+    {
+        TLRENDER_P();
+        p.entries.remove_if(
+            [&files](const Private::Entry& entry)
+            {
+                return std::find(files.begin(), files.end(), entry.item) ==
+                       files.end();
+            });
+    }
+
+    void PlayerPool::clear()
+    {
+        _p->entries.clear();
+    }
+
+    bool PlayerPool::isEmpty() const
+    {
+        return _p->entries.empty();
+    }
+
+    uint64_t PlayerPool::_setCacheOptions(
+        const std::shared_ptr<TimelinePlayer>& player)
+    {
+        TLRENDER_P();
+
+        // Without a memory budget or a frame size to share it by, the
+        // player keeps no frames besides the current one.
+        double seconds = 0.0;
+        size_t size = 0;
+        const auto& ioInfo = player->ioInfo();
+        if (!ioInfo.video.empty())
+            size = image::getDataByteCount(ioInfo.video[0]);
+        if (p.maxBytes > 0 && size > 0)
+        {
+            const double frames =
+                p.maxBytes / static_cast<double>(kMaxPlayers * size);
+            seconds = frames / player->defaultSpeed();
+        }
+
+        // Keep the frames around the current time that fit in the share of
+        // the player, but do not read more than it already had.
+        auto innerPlayer = player->player();
+        auto options = innerPlayer->observeCacheOptions()->get();
+        options.readAhead = std::min(
+            options.readAhead, otime::RationalTime(seconds * 0.75, 1.0));
+        options.readBehind = std::min(
+            options.readBehind, otime::RationalTime(seconds * 0.25, 1.0));
+        innerPlayer->setCacheOptions(options);
+
+        const double frames =
+            (options.readAhead + options.readBehind).to_seconds() *
+                player->defaultSpeed() +
+            1.0;
+        return static_cast<uint64_t>(frames * size);
+    }
+
+    void PlayerPool::trim()
+    {
+        TLRENDER_P();
+        while (p.entries.size() > kMaxPlayers)
+            p.entries.pop_back();
+        if (p.entries.empty())
+            return;
+
+        uint64_t totalVirtualMem = 0;
+        uint64_t virtualMemUsed = 0;
+        uint64_t virtualMemUsedByMe = 0;
+        uint64_t totalPhysMem = 0;
+        uint64_t physMemUsed = 0;
+        uint64_t physMemUsedByMe = 0;
+        memory_information(
+            totalVirtualMem, virtualMemUsed, virtualMemUsedByMe, totalPhysMem,
+            physMemUsed, physMemUsedByMe);
+        const uint64_t limit = totalPhysMem * kMaxMemoryFraction;
+        if (physMemUsedByMe <= limit)
+            return;
+
+        // Release the players until the memory over the limit is freed.
+        // The A player may be using the rest, so the pool never releases
+        // more than the caches of its own players.  Memory information is
+        // in megabytes.
+        const uint64_t over = (physMemUsedByMe - limit) * memory::megabyte;
+        uint64_t freed = 0;
+        while (!p.entries.empty() && freed < over)
+        {
+            LOG_INFO(
+                _("Memory is low.  Releasing the cache of ")
+                << p.entries.back().item->path.get());
+            freed += p.entries.back().bytes;
+            p.entries.pop_back();
+        }
+    }
+
+    void PlayerPool::timerEvent()
+    {
+        trim();
+        if (!_p->entries.empty())
+            Fl::repeat_timeout(
+                kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
+    }
+
+    void PlayerPool::timerEvent_cb(void* d)
+    {
+        PlayerPool* t = static_cast<PlayerPool*>(d);
+        t->timerEvent();
+    }
+} // namespace mrv
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mrvFl/mrvTimelinePlayer.h"
+
+namespace mrv
+{
+    struct FilesModelItem;
+
+    /**
+     * Players of the files that were the A file recently, kept alive so
+     * switching back to them shows their cached frames at once instead of
+     * reading them again.
+     *
+     * Parked players are stopped and their caches are shrunk to a share of
+     * the memory given to the pool.  The least recently used players are
+     * destroyed when there are too many of them or when mrv2 uses too much
+     * of the physical memory, which is checked periodically while there
+     * are parked players.
+     */
+    class PlayerPool
+    {
+    public:
+        PlayerPool();
+        ~PlayerPool();
+
+        //! Set the memory shared by the parked players, in bytes.  With 0
+        //! they keep no frames besides their current one.
+        void setMaxBytes(const uint64_t);
+
+        //! Keep the player of a file that is no longer the A file.
+        void park(
+            const std::shared_ptr<FilesModelItem>&,
+            const std::shared_ptr<TimelinePlayer>&);
+
+        //! Take the player of a file out of the pool.  Returns null if
+        //! there is none or if it was not made for the timeline.
+        std::shared_ptr<TimelinePlayer> take(
+            const std::shared_ptr<FilesModelItem>&,
+            const std::shared_ptr<timeline::Timeline>&);
+
+        //! Destroy the players of files that are no longer open.
+        void prune(const std::vector<std::shared_ptr<FilesModelItem> >&);
+
+        //! Destroy all the players.
+        void clear();
+
+        bool isEmpty() const;
+
+        //! Destroy the least recently used players if there are too many
+        //! or if mrv2 uses too much memory.
+        void trim();
+
+    private:
+        //! Shrink the cache of a player and return the bytes it may use.
+        uint64_t _setCacheOptions(const std::shared_ptr<TimelinePlayer>&);
+
+        void timerEvent();
+        static void timerEvent_cb(void*);
+
+        TLRENDER_PRIVATE();
+    };
+} // namespace mrv
@@ -130,6 +130,7 @@ namespace mrv
         p.defaultValues["Performance/FFmpegThreadCount"] = 0;
         p.defaultValues["Performance/FFmpegYUVToRGBConversion"] = 0;
         p.defaultValues["Performance/FFmpegColorAccuracy"] = 0;
+        p.defaultValues["Performance/ReadbackBuffers"] = 3;
         p.defaultValues["Misc/MaxFileSequenceDigits"] = 9;
         p.defaultValues["EnvironmentMap/Sphere/SubdivisionX"] = 36;
         p.defaultValues["EnvironmentMap/Sphere/SubdivisionY"] = 36;
@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define MRV2_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    include <arm_neon.h>
+#    define MRV2_SIMD_NEON
+#endif
+
+#include "mrvCore/mrvColorAreaStats.h"
+
+namespace
+{
+    //! Min, max and sum of a BGRA scanline.
+    inline void reduceRow(
+        const float* row, const int count, mrv::area::Partial& tile) noexcept
+    {
+#if defined(MRV2_SIMD_SSE2)
+        __m128 vmin = _mm_loadu_ps(tile.min);
+        __m128 vmax = _mm_loadu_ps(tile.max);
+        __m128 vsum = _mm_setzero_ps();
+        for (int i = 0; i < count; ++i, row += 4)
+        {
+            const __m128 pixel = _mm_loadu_ps(row);
+            vmin = _mm_min_ps(vmin, pixel);
+            vmax = _mm_max_ps(vmax, pixel);
+            vsum = _mm_add_ps(vsum, pixel);
+        }
+        float sum[4];
+        _mm_storeu_ps(tile.min, vmin);
+        _mm_storeu_ps(tile.max, vmax);
+        _mm_storeu_ps(sum, vsum);
+#elif defined(MRV2_SIMD_NEON)
+        float32x4_t vmin = vld1q_f32(tile.min);
+        float32x4_t vmax = vld1q_f32(tile.max);
+        float32x4_t vsum = vdupq_n_f32(0.F);
+        for (int i = 0; i < count; ++i, row += 4)
+        {
+            const float32x4_t pixel = vld1q_f32(row);
+            vmin = vminq_f32(vmin, pixel);
+            vmax = vmaxq_f32(vmax, pixel);
+            vsum = vaddq_f32(vsum, pixel);
+        }
+        float sum[4];
+        vst1q_f32(tile.min, vmin);
+        vst1q_f32(tile.max, vmax);
+        vst1q_f32(sum, vsum);
+#else
+        float sum[4] = {0.F, 0.F, 0.F, 0.F};
+        for (int i = 0; i < count; ++i, row += 4)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                tile.min[c] = std::min(tile.min[c], row[c]);
+                tile.max[c] = std::max(tile.max[c], row[c]);
+                sum[c] += row[c];
+            }
+        }
+#endif
+        for (int c = 0; c < 4; ++c)
+            tile.sum[c] += sum[c];
+    }
+
+    //! Color space conversion and brightness of a BGRA scanline.  The
+    //! conversion is passed in as a template functor so the color space
+    //! switch is done once per scanline instead of once per pixel.
+    template <typename Convert>
+    inline void reduceHSVRow(
+        const float* row, const int count, mrv::area::Partial& tile,
+        const mrv::BrightnessType brightnessType, Convert convert) noexcept
+    {
+        float sum[4] = {0.F, 0.F, 0.F, 0.F};
+        for (int i = 0; i < count; ++i, row += 4)
+        {
+            tl::image::Color4f rgba(row[2], row[1], row[0], row[3]);
+            tl::image::Color4f hsv = convert(rgba);
+            hsv.a = mrv::calculate_brightness(rgba, brightnessType);
+
+            const float values[4] = {hsv.r, hsv.g, hsv.b, hsv.a};
+            for (int c = 0; c < 4; ++c)
+            {
+                tile.hsvMin[c] = std::min(tile.hsvMin[c], values[c]);
+                tile.hsvMax[c] = std::max(tile.hsvMax[c], values[c]);
+                sum[c] += values[c];
+            }
+        }
+        for (int c = 0; c < 4; ++c)
+            tile.hsvSum[c] += sum[c];
+    }
+
+    inline void reduceHSVRow(
+        const float* row, const int count, mrv::area::Partial& tile,
+        const int space, const mrv::BrightnessType brightnessType) noexcept
+    {
+        using namespace mrv::color;
+        using tl::image::Color4f;
+
+        // rgba_to_space clamps the color to [0..1], which is then used for
+        // the brightness too.
+        auto clamped = [](Color4f& c)
+        {
+            c.r = std::clamp(c.r, 0.F, 1.F);
+            c.g = std::clamp(c.g, 0.F, 1.F);
+            c.b = std::clamp(c.b, 0.F, 1.F);
+        };
+
+        switch (space)
+        {
+        case kHSV:
+            reduceHSVRow(
+                row, count, tile, brightnessType,
+                [&](Color4f& c)
+                {
+                    clamped(c);
+                    return rgb::to_hsv(c);
+                });
+            break;
+        case kHSL:
+            reduceHSVRow(
+                row, count, tile, brightnessType,
+                [&](Color4f& c)
+                {
+                    clamped(c);
+                    return rgb::to_hsl(c);
+                });
+            break;
+        case kRGB:
+            reduceHSVRow(
+                row, count, tile, brightnessType,
+                [&](Color4f& c)
+                {
+                    clamped(c);
+                    return c;
+                });
+            break;
+        default:
+            reduceHSVRow(
+                row, count, tile, brightnessType,
+                [space](Color4f& c) { return rgba_to_space(space, c); });
+            break;
+        }
+    }
+
+    inline void toInfo(
+        mrv::area::Channels& channels, const float* min, const float* max,
+        const double* sum, const size_t num, const bool bgra) noexcept
+    {
+        const int r = bgra ? 2 : 0;
+        const int b = bgra ? 0 : 2;
+
+        channels.min = tl::image::Color4f(min[r], min[1], min[b], min[3]);
+        channels.max = tl::image::Color4f(max[r], max[1], max[b], max[3]);
+        if (num > 0)
+            channels.mean = tl::image::Color4f(
+                sum[r] / num, sum[1] / num, sum[b] / num, sum[3] / num);
+
+        channels.diff.r = channels.max.r - channels.min.r;
+        channels.diff.g = channels.max.g - channels.min.g;
+        channels.diff.b = channels.max.b - channels.min.b;
+        channels.diff.a = channels.max.a - channels.min.a;
+    }
+} // namespace
+
+namespace mrv
+{
+    namespace area
+    {
+        Partial::Partial()
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                min[i] = hsvMin[i] = std::numeric_limits<float>::max();
+                max[i] = hsvMax[i] = std::numeric_limits<float>::lowest();
+                sum[i] = hsvSum[i] = 0.0;
+            }
+        }
+
+        void accumulate(
+            Partial& partial, const float* row, const int count,
+            const int hsvColorspace,
+            const BrightnessType brightnessType) noexcept
+        {
+            reduceRow(row, count, partial);
+            reduceHSVRow(row, count, partial, hsvColorspace, brightnessType);
+            partial.count += count;
+        }
+
+        void merge(Info& info, const std::vector<Partial>& partials) noexcept
+        {
+            Partial total;
+            for (const auto& tile : partials)
+            {
+                for (int c = 0; c < 4; ++c)
+                {
+                    total.min[c] = std::min(total.min[c], tile.min[c]);
+                    total.max[c] = std::max(total.max[c], tile.max[c]);
+                    total.sum[c] += tile.sum[c];
+                    total.hsvMin[c] =
+                        std::min(total.hsvMin[c], tile.hsvMin[c]);
+                    total.hsvMax[c] =
+                        std::max(total.hsvMax[c], tile.hsvMax[c]);
+                    total.hsvSum[c] += tile.hsvSum[c];
+                }
+                total.count += tile.count;
+            }
+
+            toInfo(
+                info.rgba, total.min, total.max, total.sum, total.count, true);
+            toInfo(
+                info.hsv, total.hsvMin, total.hsvMax, total.hsvSum,
+                total.count, false);
+        }
+    } // namespace area
+} // namespace mrv
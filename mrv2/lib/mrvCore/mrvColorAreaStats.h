@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <vector>
+
+#include "mrvCore/mrvColorSpaces.h"
+
+#include "mrvFl/mrvColorAreaInfo.h"
+
+namespace mrv
+{
+    namespace area
+    {
+        /**
+         * Partial color area statistics (min, max and sums of RGBA and of
+         * the HSV/brightness channels) of a tile of scanlines.  The rgba
+         * channels are kept in BGRA order, as they come from the buffer.
+         * Min, max and sums are accumulated with SSE2 or NEON when
+         * available.
+         */
+        struct Partial
+        {
+            Partial();
+
+            float min[4];
+            float max[4];
+            double sum[4];
+
+            float hsvMin[4];
+            float hsvMax[4];
+            double hsvSum[4];
+
+            size_t count = 0;
+        };
+
+        /**
+         * Accumulate a BGRA float scanline into a Partial.
+         *
+         * @param partial        Partial to update.
+         * @param row            First pixel of the scanline.
+         * @param count          Number of pixels in the scanline.
+         * @param hsvColorspace  color::Space for the hsv channels.
+         * @param brightnessType brightness type for the hsv.a channel.
+         */
+        void accumulate(
+            Partial& partial, const float* row, const int count,
+            const int hsvColorspace,
+            const BrightnessType brightnessType) noexcept;
+
+        //! Merge partial statistics into the rgba and hsv channels of info.
+        void merge(Info& info, const std::vector<Partial>& partials) noexcept;
+    } // namespace area
+} // namespace mrv
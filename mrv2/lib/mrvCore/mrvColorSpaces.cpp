@@ -482,6 +482,61 @@ namespace mrv
             }
         }
 
+        /**
+         * @brief Clamp a rgba color and convert it to another color space.
+         *
+         * @param space color::Space to convert to.
+         * @param rgba RGBA color, clamped in place to [0..1].
+         *
+         * @return the converted color.
+         */
+        image::Color4f rgba_to_space(int space, image::Color4f& rgba) noexcept
+        {
+            if (rgba.r < 0.F)
+                rgba.r = 0.F;
+            else if (rgba.r > 1.F)
+                rgba.r = 1.F;
+            if (rgba.g < 0.F)
+                rgba.g = 0.F;
+            else if (rgba.g > 1.F)
+                rgba.g = 1.F;
+            if (rgba.b < 0.F)
+                rgba.b = 0.F;
+            else if (rgba.b > 1.F)
+                rgba.b = 1.F;
+
+            switch (space)
+            {
+            case kHSV:
+                return rgb::to_hsv(rgba);
+            case kHSL:
+                return rgb::to_hsl(rgba);
+#ifdef TLRENDER_HSV
+            case kCIE_XYZ:
+                return rgb::to_xyz(rgba);
+            case kCIE_xyY:
+                return rgb::to_xyY(rgba);
+            case kCIE_Lab:
+                return rgb::to_lab(rgba);
+            case kCIE_Luv:
+                return rgb::to_luv(rgba);
+#endif
+            case kYUV:
+                return rgb::to_yuv(rgba);
+            case kYDbDr:
+                return rgb::to_YDbDr(rgba);
+            case kYIQ:
+                return rgb::to_yiq(rgba);
+            case kITU_601:
+                return rgb::to_ITU601(rgba);
+            case kITU_709:
+                return rgb::to_ITU709(rgba);
+            case kRGB:
+            default:
+                return rgba;
+            }
+        }
+
         //! Convert tlRender's layer names to more human readable ones.
         std::string layer(const std::string layerName)
         {
@@ -146,6 +146,17 @@ namespace mrv
         void
         checkLevels(image::Color4f& rgba, const image::VideoLevels videoLevels);
 
+        /**
+         * Clamp a rgba color to the [0..1] range and convert it to another
+         * color space.
+         *
+         * @param space color::Space to convert to.
+         * @param rgba  RGBA color.  It is clamped in place.
+         *
+         * @return the color in the new color space.
+         */
+        image::Color4f rgba_to_space(int space, image::Color4f& rgba) noexcept;
+
         //! Convert tlRender's layer to more human readable ones.
         std::string layer(const std::string tlRenderLayer);
 
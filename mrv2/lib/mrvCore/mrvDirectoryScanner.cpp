@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <mutex>
+namespace fs = std::filesystem;
+
+#ifndef _WIN32
+#    include <dirent.h>
+#endif
+
+#include "mrvCore/mrvDirectoryScanner.h"
+#include "mrvCore/mrvFile.h"
+#include "mrvCore/mrvThreadPool.h"
+
+namespace
+{
+    //! Directories whose listing is kept.
+    const size_t kMaxCached = 16;
+
+    //! Entries whose names are parsed by each task of the thread pool.
+    const unsigned kParseChunk = 1024;
+
+    //! Time after which a modification of a directory shows in its
+    //! modification time.  Listings made sooner are not reused, as files
+    //! added in the same tick of a coarse (e.g. NFS) clock would be
+    //! missed.
+    const std::chrono::seconds kSettleTime(2);
+
+    void addEntry(
+        std::vector<mrv::DirectoryEntry>& entries, const std::string& name,
+        const bool isDir)
+    {
+        mrv::DirectoryEntry entry;
+        entry.name = name;
+        entry.isDir = isDir;
+        entries.push_back(entry);
+    }
+
+    bool readEntries(
+        const std::string& directory, std::vector<mrv::DirectoryEntry>& out)
+    {
+#ifdef _WIN32
+        // The entries carry their attributes, so checking for directories
+        // needs no extra call.
+        std::error_code ec;
+        fs::directory_iterator i(fs::u8path(directory), ec);
+        if (ec)
+            return false;
+        for (; i != fs::directory_iterator(); i.increment(ec))
+        {
+            if (ec)
+                break;
+            addEntry(
+                out, i->path().filename().u8string(), i->is_directory(ec));
+        }
+        return true;
+#else
+        DIR* dir = opendir(directory.c_str());
+        if (!dir)
+            return false;
+        while (struct dirent* e = readdir(dir))
+        {
+            const char* name = e->d_name;
+            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0)
+                continue;
+
+            bool isDir = false;
+#    ifdef DT_DIR
+            if (e->d_type == DT_DIR)
+                isDir = true;
+            else if (e->d_type != DT_REG)
+#    endif
+            {
+                // Symbolic links and file systems that do not fill in
+                // d_type need a stat.
+                std::error_code ec;
+                const auto status = fs::status(directory + "/" + name, ec);
+                if (ec || !fs::exists(status))
+                    continue;
+                isDir = fs::is_directory(status);
+            }
+            addEntry(out, name, isDir);
+        }
+        closedir(dir);
+        return true;
+#endif
+    }
+
+    void parseEntry(mrv::DirectoryEntry& entry)
+    {
+        if (entry.isDir)
+            return;
+
+        const mrv::file::Path path(entry.name);
+        entry.parts.root = path.getBaseName();
+        entry.parts.number = path.getNumber();
+        entry.parts.ext = path.getExtension();
+        entry.parts.frame = std::strtoll(entry.parts.number.c_str(), 0, 10);
+        entry.isSequence = mrv::file::isSequence(path);
+    }
+} // namespace
+
+namespace mrv
+{
+    struct DirectoryScanner::Private
+    {
+        struct Cached
+        {
+            std::shared_ptr<const DirectoryListing> listing;
+            fs::file_time_type time;
+        };
+
+        //! Cached listings, most recently used first.
+        std::list<Cached> cache;
+
+        //! Listings being made.
+        std::map<
+            std::string,
+            std::shared_future<std::shared_ptr<const DirectoryListing> > >
+            scans;
+
+        std::mutex mutex;
+    };
+
+    DirectoryScanner::DirectoryScanner() :
+        _p(new Private)
+    {
+    }
+
+    DirectoryScanner::~DirectoryScanner() {}
+
+    DirectoryScanner& DirectoryScanner::instance()
+    {
+        static DirectoryScanner scanner;
+        return scanner;
+    }
+
+    std::shared_future<std::shared_ptr<const DirectoryListing> >
+    DirectoryScanner::scan(const std::string& directory)
+    {
+        TLRENDER_P();
+        std::unique_lock<std::mutex> lock(p.mutex);
+
+        auto i = p.scans.find(directory);
+        if (i != p.scans.end())
+            return i->second;
+
+        auto promise = std::make_shared<
+            std::promise<std::shared_ptr<const DirectoryListing> > >();
+        std::shared_future<std::shared_ptr<const DirectoryListing> > out =
+            promise->get_future().share();
+        p.scans[directory] = out;
+
+        ThreadPool::instance().async(
+            [this, directory, promise]
+            {
+                auto listing = _list(directory);
+                {
+                    std::unique_lock<std::mutex> lock(_p->mutex);
+                    _p->scans.erase(directory);
+                }
+                promise->set_value(listing);
+            });
+        return out;
+    }
+
+    std::shared_ptr<const DirectoryListing>
+    DirectoryScanner::list(const std::string& directory)
+    {
+        return scan(directory).get();
+    }
+
+    std::shared_ptr<const DirectoryListing>
+    DirectoryScanner::_list(const std::string& directory)
+    {
+        TLRENDER_P();
+
+        std::error_code ec;
+        const auto time = fs::last_write_time(fs::u8path(directory), ec);
+        if (!ec)
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            for (auto i = p.cache.begin(); i != p.cache.end(); ++i)
+            {
+                if (i->listing->directory != directory)
+                    continue;
+                if (i->time != time)
+                {
+                    p.cache.erase(i);
+                    break;
+                }
+                p.cache.splice(p.cache.begin(), p.cache, i);
+                return i->listing;
+            }
+        }
+
+        const auto start = fs::file_time_type::clock::now();
+
+        auto listing = std::make_shared<DirectoryListing>();
+        listing->directory = directory;
+        listing->valid = readEntries(directory, listing->entries);
+
+        // Parsing the names goes through tlRender's path parsing, which is
+        // the bulk of the work for big sequences.
+        auto& entries = listing->entries;
+        const unsigned chunks =
+            (entries.size() + kParseChunk - 1) / kParseChunk;
+        ThreadPool::instance().parallel_for(
+            chunks,
+            [&entries](unsigned chunk)
+            {
+                const size_t start = chunk * size_t(kParseChunk);
+                const size_t end =
+                    std::min(entries.size(), start + kParseChunk);
+                for (size_t i = start; i < end; ++i)
+                    parseEntry(entries[i]);
+            });
+
+        if (!ec && listing->valid && start - time > kSettleTime)
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cache.push_front({listing, time});
+            if (p.cache.size() > kMaxCached)
+                p.cache.pop_back();
+        }
+        return listing;
+    }
+
+} // namespace mrv
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <tlCore/Util.h>
+
+#include "mrvCore/mrvSequence.h"
+
+namespace mrv
+{
+    //! An entry of a directory.
+    struct DirectoryEntry
+    {
+        std::string name;
+        bool isDir = false;
+
+        //! Whether the file may be a frame of an image sequence.
+        bool isSequence = false;
+
+        //! Parts of the file name, with the frame number parsed.
+        Sequence parts;
+    };
+
+    //! The entries of a directory, in no particular order.
+    struct DirectoryListing
+    {
+        std::string directory;
+        std::vector<DirectoryEntry> entries;
+
+        //! Whether the directory could be read.
+        bool valid = false;
+    };
+
+    /**
+     * Lists directories on the thread pool, so big directories on network
+     * shares do not block the user interface.
+     *
+     * Entries are typed from the directory itself where the file system
+     * allows it, without a stat per entry, and their names are parsed on
+     * the scanner too.  Listings are cached and reused until the
+     * modification time of their directory changes.
+     */
+    class DirectoryScanner
+    {
+    public:
+        ~DirectoryScanner();
+
+        //! Return the global directory scanner.
+        static DirectoryScanner& instance();
+
+        //! Start listing a directory.  Listings of a directory already
+        //! being scanned are shared.
+        std::shared_future<std::shared_ptr<const DirectoryListing> >
+        scan(const std::string& directory);
+
+        //! List a directory and wait for it.
+        std::shared_ptr<const DirectoryListing>
+        list(const std::string& directory);
+
+    private:
+        DirectoryScanner();
+
+        std::shared_ptr<const DirectoryListing>
+        _list(const std::string& directory);
+
+        TLRENDER_PRIVATE();
+    };
+
+} // namespace mrv
@@ -104,12 +104,11 @@ namespace mrv
             return false;
         }
 
-        bool isSequence(const std::string& filename)
+        bool isSequence(const Path& path)
         {
             auto context = App::app->getContext();
             auto ioSystem = context->getSystem<tl::io::System>();
 
-            const file::Path path(filename);
             const std::string& extension = path.getExtension();
             switch (ioSystem->getFileType(extension))
             {
@@ -89,15 +89,15 @@ namespace mrv
          * a sequence on disk (ie. there are several images named with a
          * similar convention)
          *
-         * @param file Filename of image
+         * @param path Path of image
          *
          * @return true if a possible sequence, false if not.
          */
-        bool isSequence(const std::string& file);
+        bool isSequence(const Path& path);
 
-        inline bool isSequence(const Path& path)
+        inline bool isSequence(const std::string& file)
         {
-            return isSequence(path.get());
+            return isSequence(Path(file));
         }
         
         /**
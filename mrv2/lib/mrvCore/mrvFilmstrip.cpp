@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <set>
+
+#include "mrvCore/mrvFilmstrip.h"
+
+namespace
+{
+    //! Samples of the whole clip, before it is refined.
+    const int64_t kInitialSamples = 32;
+
+    //! Samples wanted over the visible range of the timeline.
+    const int64_t kSamplesPerView = 64;
+
+    //! Requests sent to the thumbnail cache at a time, so the samples do
+    //! not delay the other thumbnails.
+    const size_t kMaxRequests = 4;
+
+    //! Most samples kept for a clip.
+    const size_t kMaxSamples = 512;
+
+    //! Cells of a page of the atlas.
+    const int kPageColumns = 8;
+    const int kPageRows = 8;
+    const int kPageCells = kPageColumns * kPageRows;
+} // namespace
+
+namespace mrv
+{
+    struct Filmstrip::Private
+    {
+        std::weak_ptr<ui::ThumbnailSystem> thumbnailSystem;
+        file::Path path;
+        otime::TimeRange timeRange;
+        int height = 0;
+        io::Options options;
+
+        //! Samples are indexed by their frame from the start of the clip.
+        int64_t duration = 1;
+        int64_t baseStep = 1;
+        int64_t visibleFirst = 0;
+        int64_t visibleLast = 0;
+
+        //! Cells of the samples.
+        std::map<int64_t, int> samples;
+        std::map<int64_t, ThumbnailRequest> requests;
+        std::set<int64_t> failed;
+
+        //! Whether all the samples wanted were requested.
+        bool idle = false;
+
+        int cellWidth = 0;
+        int cellHeight = 0;
+        std::vector<std::shared_ptr<ThumbnailPixels> > pages;
+
+        int64_t toFrame(const otime::RationalTime& time) const
+        {
+            const double rate = timeRange.duration().rate();
+            const int64_t out = std::llround(
+                time.rescaled_to(rate).value() -
+                timeRange.start_time().rescaled_to(rate).value());
+            return std::max(int64_t(0), std::min(out, duration - 1));
+        }
+
+        otime::RationalTime toTime(const int64_t frame) const
+        {
+            const double rate = timeRange.duration().rate();
+            return otime::RationalTime(
+                timeRange.start_time().rescaled_to(rate).value() + frame,
+                rate);
+        }
+
+        bool isKnown(const int64_t frame) const
+        {
+            return samples.count(frame) || requests.count(frame) ||
+                   failed.count(frame);
+        }
+
+        //! Find the next frame to sample, coarsest first.
+        bool next(int64_t& out) const
+        {
+            for (int64_t frame = 0; frame < duration; frame += baseStep)
+            {
+                if (!isKnown(frame))
+                {
+                    out = frame;
+                    return true;
+                }
+            }
+
+            const int64_t wanted = std::max(
+                int64_t(1),
+                (visibleLast - visibleFirst + 1) / kSamplesPerView);
+            for (int64_t step = baseStep / 2; step >= wanted; step /= 2)
+            {
+                const int64_t first = (visibleFirst + step - 1) / step * step;
+                for (int64_t frame = first; frame <= visibleLast;
+                     frame += step)
+                {
+                    if (!isKnown(frame))
+                    {
+                        out = frame;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void add(const int64_t frame, const ThumbnailPixels& pixels)
+        {
+            if (samples.count(frame) || samples.size() >= kMaxSamples)
+                return;
+
+            if (cellWidth == 0)
+            {
+                cellWidth = pixels.getWidth();
+                cellHeight = pixels.getHeight();
+            }
+
+            const int index = samples.size();
+            const int page = index / kPageCells;
+            if (page >= static_cast<int>(pages.size()))
+            {
+                // Pages are bigger than thumbnails and would only push
+                // them out of the pool, so they are not pooled.
+                pages.push_back(ThumbnailPixels::create(
+                    cellWidth * kPageColumns, cellHeight * kPageRows, false));
+            }
+
+            // Clips of a timeline may not share a size, so the cells of
+            // smaller thumbnails are cleared and bigger ones are cropped.
+            const int cell = index % kPageCells;
+            const size_t stride = pages[page]->getWidth() * 4;
+            uint8_t* d = pages[page]->getData() +
+                         (cell / kPageColumns) * cellHeight * stride +
+                         (cell % kPageColumns) * cellWidth * 4;
+            const int w = std::min(cellWidth, pixels.getWidth());
+            const int h = std::min(cellHeight, pixels.getHeight());
+            const bool clear = w < cellWidth || h < cellHeight;
+            for (int y = 0; y < cellHeight; ++y, d += stride)
+            {
+                if (clear)
+                    memset(d, 0, cellWidth * 4);
+                if (y < h)
+                {
+                    memcpy(
+                        d, pixels.getData() + y * pixels.getWidth() * 4,
+                        w * 4);
+                }
+            }
+            samples[frame] = index;
+        }
+    };
+
+    Filmstrip::Filmstrip(
+        const std::shared_ptr<ui::ThumbnailSystem>& thumbnailSystem,
+        const file::Path& path, const otime::TimeRange& timeRange,
+        const int height, const io::Options& options) :
+        _p(new Private)
+    {
+        TLRENDER_P();
+        p.thumbnailSystem = thumbnailSystem;
+        p.path = path;
+        p.timeRange = timeRange;
+        p.height = height;
+        p.options = options;
+
+        p.duration = std::max(
+            int64_t(1), int64_t(std::llround(timeRange.duration().value())));
+        const int64_t step =
+            (p.duration + kInitialSamples - 1) / kInitialSamples;
+        while (p.baseStep < step)
+            p.baseStep *= 2;
+        p.visibleLast = p.duration - 1;
+    }
+
+    Filmstrip::~Filmstrip()
+    {
+        TLRENDER_P();
+        std::vector<uint64_t> ids;
+        for (const auto& i : p.requests)
+            ids.push_back(i.second.id);
+        if (!ids.empty())
+            ThumbnailCache::instance().cancelRequests(ids);
+    }
+
+    const file::Path& Filmstrip::getPath() const
+    {
+        return _p->path;
+    }
+
+    const otime::TimeRange& Filmstrip::getTimeRange() const
+    {
+        return _p->timeRange;
+    }
+
+    void Filmstrip::setVisibleRange(const otime::TimeRange& value)
+    {
+        TLRENDER_P();
+        const int64_t first = p.toFrame(value.start_time());
+        const int64_t last = p.toFrame(value.end_time_inclusive());
+        if (first == p.visibleFirst && last == p.visibleLast)
+            return;
+        p.visibleFirst = first;
+        p.visibleLast = last;
+        p.idle = false;
+    }
+
+    void Filmstrip::addSample(
+        const otime::RationalTime& time,
+        const std::shared_ptr<ThumbnailPixels>& pixels)
+    {
+        if (pixels)
+            _p->add(_p->toFrame(time), *pixels);
+    }
+
+    bool Filmstrip::tick()
+    {
+        TLRENDER_P();
+
+        bool out = false;
+        for (auto i = p.requests.begin(); i != p.requests.end();)
+        {
+            auto& future = i->second.future;
+            if (future.wait_for(std::chrono::seconds(0)) !=
+                std::future_status::ready)
+            {
+                ++i;
+                continue;
+            }
+            if (auto pixels = future.get())
+            {
+                p.add(i->first, *pixels);
+                out = true;
+            }
+            else
+            {
+                p.failed.insert(i->first);
+            }
+            i = p.requests.erase(i);
+        }
+
+        if (!p.idle)
+            _request();
+        return out;
+    }
+
+    ThumbnailImage* Filmstrip::getImage(
+        const otime::RationalTime& time, otime::RationalTime* sampleTime) const
+    {
+        TLRENDER_P();
+        if (p.samples.empty())
+            return nullptr;
+
+        const int64_t frame = p.toFrame(time);
+        auto i = p.samples.lower_bound(frame);
+        if (i == p.samples.end() ||
+            (i != p.samples.begin() &&
+             frame - std::prev(i)->first < i->first - frame))
+            --i;
+
+        if (sampleTime)
+            *sampleTime = p.toTime(i->first);
+
+        const int cell = i->second % kPageCells;
+        return new ThumbnailImage(
+            p.pages[i->second / kPageCells],
+            (cell % kPageColumns) * p.cellWidth,
+            (cell / kPageColumns) * p.cellHeight, p.cellWidth, p.cellHeight);
+    }
+
+    void Filmstrip::_request()
+    {
+        TLRENDER_P();
+
+        auto thumbnailSystem = p.thumbnailSystem.lock();
+        if (!thumbnailSystem)
+            return;
+
+        while (p.requests.size() < kMaxRequests &&
+               p.samples.size() + p.requests.size() < kMaxSamples)
+        {
+            int64_t frame = 0;
+            if (!p.next(frame))
+            {
+                p.idle = true;
+                break;
+            }
+            p.requests[frame] = ThumbnailCache::instance().getThumbnail(
+                thumbnailSystem, p.path, p.height, p.toTime(frame),
+                p.options);
+        }
+    }
+
+} // namespace mrv
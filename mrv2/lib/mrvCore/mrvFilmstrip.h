@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <memory>
+
+#include "mrvCore/mrvThumbnailCache.h"
+
+namespace mrv
+{
+    /**
+     * Thumbnails of a clip sampled in the background and packed into an
+     * atlas, so the timeline can show a thumbnail as soon as the mouse
+     * hovers over it.
+     *
+     * The whole clip is sampled first at a coarse interval.  The interval
+     * is then halved over the visible range of the timeline until there
+     * are enough samples for its zoom, so zooming in refines the samples
+     * progressively.  Samples are requested through the thumbnail cache,
+     * a few at a time, so they are shared with the other thumbnails and
+     * kept between sessions.
+     *
+     * The atlas is made of pages of cells in main memory, as the hover
+     * thumbnails are drawn by FLTK.  Images of the samples draw their cell
+     * of the page without copying it.
+     */
+    class Filmstrip
+    {
+    public:
+        Filmstrip(
+            const std::shared_ptr<ui::ThumbnailSystem>&, const file::Path&,
+            const otime::TimeRange&, const int height,
+            const io::Options& = io::Options());
+
+        ~Filmstrip();
+
+        const file::Path& getPath() const;
+        const otime::TimeRange& getTimeRange() const;
+
+        //! Set the range shown by the timeline, which is sampled more
+        //! finely as it gets shorter.
+        void setVisibleRange(const otime::TimeRange&);
+
+        //! Add a thumbnail made elsewhere, like the exact one of a hover.
+        void addSample(
+            const otime::RationalTime&,
+            const std::shared_ptr<ThumbnailPixels>&);
+
+        //! Collect the finished samples and request new ones.  Returns
+        //! whether samples were added.
+        bool tick();
+
+        /**
+         * Return an image of the sample nearest to a time, or null if
+         * there are no samples yet.  The caller owns the image.  The time
+         * of the sample is returned in sampleTime.
+         */
+        ThumbnailImage* getImage(
+            const otime::RationalTime&,
+            otime::RationalTime* sampleTime = nullptr) const;
+
+    private:
+        void _request();
+
+        TLRENDER_PRIVATE();
+    };
+
+} // namespace mrv
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <cstdio>
+
+#include "mrvCore/mrvHash.h"
+
+namespace mrv
+{
+    uint64_t hash(const void* data, const size_t size, const uint64_t seed)
+    {
+        uint64_t out = seed;
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            out ^= bytes[i];
+            out *= 1099511628211ULL;
+        }
+        return out;
+    }
+
+    uint64_t hash(const std::string& value)
+    {
+        return hash(value.data(), value.size());
+    }
+
+    std::string hashToHex(const uint64_t value)
+    {
+        char buf[17];
+        snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)value);
+        return buf;
+    }
+} // namespace mrv
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mrv
+{
+    //! Initial value of a hash.
+    const uint64_t kHashSeed = 14695981039346656037ULL;
+
+    /**
+     * 64-bit FNV-1a hash of some bytes.  It is fast but not
+     * cryptographic, for cache keys and signatures.
+     *
+     * @param seed Hash to continue, so several values can be hashed
+     *             together.
+     */
+    uint64_t hash(const void* data, const size_t size,
+                  const uint64_t seed = kHashSeed);
+
+    //! 64-bit FNV-1a hash of a string.
+    uint64_t hash(const std::string&);
+
+    //! Return a hash as 16 hexadecimal digits.
+    std::string hashToHex(const uint64_t);
+} // namespace mrv
@@ -0,0 +1,362 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <Imath/half.h>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define MRV2_SIMD_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#    include <arm_neon.h>
+#    define MRV2_SIMD_NEON
+#endif
+
+#include "mrvCore/mrvPixelDecode.h"
+
+namespace
+{
+    using namespace tl;
+    using mrv::pixel::Source;
+
+    //! Largest value of a channel, to normalize it to [0, 1].
+    template <typename T> constexpr float channelMax() noexcept
+    {
+        return static_cast<float>(std::numeric_limits<T>::max());
+    }
+    template <> constexpr float channelMax<float>() noexcept
+    {
+        return 1.F;
+    }
+    template <> constexpr float channelMax<half>() noexcept
+    {
+        return 1.F;
+    }
+
+    //! Luminance, luminance and alpha, RGB and RGBA interleaved pixels.
+    template <typename T, int channels>
+    void decodePacked(
+        float* out, const Source& source, const int x, const int y,
+        const int count)
+    {
+        constexpr float max = channelMax<T>();
+        const T* in = reinterpret_cast<const T*>(source.data) +
+                      (static_cast<size_t>(y) * source.width + x) * channels;
+        for (int i = 0; i < count; ++i, in += channels, out += 4)
+        {
+            if constexpr (channels < 3)
+            {
+                const float l = static_cast<float>(in[0]) / max;
+                out[0] = l;
+                out[1] = l;
+                out[2] = l;
+                out[3] = channels == 2 ? static_cast<float>(in[1]) / max : 1.F;
+            }
+            else
+            {
+                out[0] = static_cast<float>(in[0]) / max;
+                out[1] = static_cast<float>(in[1]) / max;
+                out[2] = static_cast<float>(in[2]) / max;
+                out[3] = channels == 4 ? static_cast<float>(in[3]) / max : 1.F;
+            }
+        }
+    }
+
+    //! 10 bit RGB packed in 32 bits.
+    void decodeU10(
+        float* out, const Source& source, const int x, const int y,
+        const int count)
+    {
+        constexpr float max = channelMax<uint32_t>();
+        const image::U10* in = reinterpret_cast<const image::U10*>(
+                                   source.data) +
+                               static_cast<size_t>(y) * source.width + x;
+        for (int i = 0; i < count; ++i, ++in, out += 4)
+        {
+            out[0] = in->r / max;
+            out[1] = in->g / max;
+            out[2] = in->b / max;
+            out[3] = 1.F;
+        }
+    }
+
+    //! Number of pixels converted from YUV to RGB at a time.
+    const int kYUVBlock = 64;
+
+    /**
+     * Convert planar Y, Pb and Pr values to interleaved RGBA, after
+     * removing the video levels.  This matches color::checkLevels() and
+     * color::YPbPr::to_rgb().
+     */
+    void convertYPbPr(
+        float* out, float* Y, float* Pb, float* Pr, const int count,
+        const Source& source)
+    {
+        float offset = 0.F, scaleY = 1.F, scaleC = 1.F;
+        if (source.videoLevels == image::VideoLevels::LegalRange)
+        {
+            offset = 16.F / 255.F;
+            scaleY = 255.F / (235.F - 16.F);
+            scaleC = 255.F / (240.F - 16.F);
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            Y[i] = std::clamp((Y[i] - offset) * scaleY, 0.F, 1.F);
+            Pb[i] = std::clamp((Pb[i] - offset) * scaleC - 0.5F, -0.5F, 0.5F);
+            Pr[i] = std::clamp((Pr[i] - offset) * scaleC - 0.5F, -0.5F, 0.5F);
+        }
+
+        const math::Vector4f& k = source.yuvCoefficients;
+        int i = 0;
+#if defined(MRV2_SIMD_SSE2)
+        const __m128 kx = _mm_set1_ps(k.x);
+        const __m128 ky = _mm_set1_ps(k.y);
+        const __m128 kz = _mm_set1_ps(k.z);
+        const __m128 kw = _mm_set1_ps(k.w);
+        const __m128 one = _mm_set1_ps(1.F);
+        for (; i + 4 <= count; i += 4, out += 16)
+        {
+            const __m128 y = _mm_loadu_ps(Y + i);
+            const __m128 cb = _mm_loadu_ps(Pb + i);
+            const __m128 cr = _mm_loadu_ps(Pr + i);
+            __m128 r = _mm_add_ps(y, _mm_mul_ps(kx, cr));
+            __m128 g = _mm_sub_ps(
+                _mm_sub_ps(y, _mm_mul_ps(kz, cb)), _mm_mul_ps(kw, cr));
+            __m128 b = _mm_add_ps(y, _mm_mul_ps(ky, cb));
+            __m128 a = one;
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+            _mm_storeu_ps(out, r);
+            _mm_storeu_ps(out + 4, g);
+            _mm_storeu_ps(out + 8, b);
+            _mm_storeu_ps(out + 12, a);
+        }
+#elif defined(MRV2_SIMD_NEON)
+        for (; i + 4 <= count; i += 4, out += 16)
+        {
+            const float32x4_t y = vld1q_f32(Y + i);
+            const float32x4_t cb = vld1q_f32(Pb + i);
+            const float32x4_t cr = vld1q_f32(Pr + i);
+            float32x4x4_t rgba;
+            rgba.val[0] = vmlaq_n_f32(y, cr, k.x);
+            rgba.val[1] = vmlsq_n_f32(vmlsq_n_f32(y, cb, k.z), cr, k.w);
+            rgba.val[2] = vmlaq_n_f32(y, cb, k.y);
+            rgba.val[3] = vdupq_n_f32(1.F);
+            vst4q_f32(out, rgba);
+        }
+#endif
+        for (; i < count; ++i, out += 4)
+        {
+            out[0] = Y[i] + k.x * Pr[i];
+            out[1] = Y[i] - k.z * Pb[i] - k.w * Pr[i];
+            out[2] = Y[i] + k.y * Pb[i];
+            out[3] = 1.F;
+        }
+    }
+
+    /**
+     * Planar YUV, with the chroma planes subsampled by subX and subY.
+     */
+    template <typename T, int subX, int subY>
+    void decodeYUV(
+        float* out, const Source& source, const int x, const int y,
+        const int count)
+    {
+        constexpr float max = channelMax<T>();
+        const size_t lumaSize =
+            static_cast<size_t>(source.width) * source.height;
+        const size_t chromaW = (source.width + subX - 1) / subX;
+        const size_t chromaH = (source.height + subY - 1) / subY;
+        const T* luma = reinterpret_cast<const T*>(source.data);
+        const T* pb = luma + lumaSize + (y / subY) * chromaW;
+        const T* pr = pb + chromaW * chromaH;
+        luma += static_cast<size_t>(y) * source.width;
+
+        float Y[kYUVBlock], Pb[kYUVBlock], Pr[kYUVBlock];
+        for (int start = 0; start < count; start += kYUVBlock)
+        {
+            const int n = std::min(kYUVBlock, count - start);
+            const int x0 = x + start;
+            for (int i = 0; i < n; ++i)
+            {
+                const int c = (x0 + i) / subX;
+                Y[i] = luma[x0 + i] / max;
+                Pb[i] = pb[c] / max;
+                Pr[i] = pr[c] / max;
+            }
+            convertYPbPr(out + start * 4, Y, Pb, Pr, n, source);
+        }
+    }
+
+    void zero(float* out, const int count)
+    {
+        if (count > 0)
+            std::memset(out, 0, static_cast<size_t>(count) * 4 * sizeof(float));
+    }
+} // namespace
+
+namespace mrv
+{
+    namespace pixel
+    {
+        DecodeFunc getDecoder(const image::PixelType type) noexcept
+        {
+            using image::PixelType;
+            switch (type)
+            {
+            case PixelType::L_U8:
+                return decodePacked<uint8_t, 1>;
+            case PixelType::L_U16:
+                return decodePacked<uint16_t, 1>;
+            case PixelType::L_U32:
+                return decodePacked<uint32_t, 1>;
+            case PixelType::L_F16:
+                return decodePacked<half, 1>;
+            case PixelType::L_F32:
+                return decodePacked<float, 1>;
+            case PixelType::LA_U8:
+                return decodePacked<uint8_t, 2>;
+            case PixelType::LA_U16:
+                return decodePacked<uint16_t, 2>;
+            case PixelType::LA_U32:
+                return decodePacked<uint32_t, 2>;
+            case PixelType::LA_F16:
+                return decodePacked<half, 2>;
+            case PixelType::LA_F32:
+                return decodePacked<float, 2>;
+            case PixelType::RGB_U8:
+                return decodePacked<uint8_t, 3>;
+            case PixelType::RGB_U10:
+                return decodeU10;
+            case PixelType::RGB_U16:
+                return decodePacked<uint16_t, 3>;
+            case PixelType::RGB_U32:
+                return decodePacked<uint32_t, 3>;
+            case PixelType::RGB_F16:
+                return decodePacked<half, 3>;
+            case PixelType::RGB_F32:
+                return decodePacked<float, 3>;
+            case PixelType::RGBA_U8:
+                return decodePacked<uint8_t, 4>;
+            case PixelType::RGBA_U16:
+                return decodePacked<uint16_t, 4>;
+            case PixelType::RGBA_U32:
+                return decodePacked<uint32_t, 4>;
+            case PixelType::RGBA_F16:
+                return decodePacked<half, 4>;
+            case PixelType::RGBA_F32:
+                return decodePacked<float, 4>;
+            case PixelType::YUV_420P_U8:
+                return decodeYUV<uint8_t, 2, 2>;
+            case PixelType::YUV_422P_U8:
+                return decodeYUV<uint8_t, 2, 1>;
+            case PixelType::YUV_444P_U8:
+                return decodeYUV<uint8_t, 1, 1>;
+            case PixelType::YUV_420P_U16:
+                return decodeYUV<uint16_t, 2, 2>;
+            case PixelType::YUV_422P_U16:
+                return decodeYUV<uint16_t, 2, 1>;
+            case PixelType::YUV_444P_U16:
+                return decodeYUV<uint16_t, 1, 1>;
+            default:
+                return nullptr;
+            }
+        }
+
+        RowDecoder::RowDecoder(
+            const std::shared_ptr<image::Image>& image, const bool mirrorX,
+            const bool mirrorY) :
+            _mirrorX(mirrorX),
+            _mirrorY(mirrorY)
+        {
+            if (!image || !image->isValid())
+                return;
+
+            const auto& info = image->getInfo();
+            _source.data = image->getData();
+            _source.width = info.size.w;
+            _source.height = info.size.h;
+            _source.videoLevels = info.videoLevels;
+            _source.yuvCoefficients =
+                image::getYUVCoefficients(info.yuvCoefficients);
+            _pixelAspectRatio = info.size.pixelAspectRatio;
+            _decode = getDecoder(info.pixelType);
+        }
+
+        int RowDecoder::_sourceX(const int X) const noexcept
+        {
+            int x = X / _pixelAspectRatio;
+            if (_mirrorX)
+                x = _source.width - x - 1;
+            return x;
+        }
+
+        void RowDecoder::decode(
+            float* out, const int X, const int Y, const int count,
+            std::vector<float>& scratch) const noexcept
+        {
+            const int W = _source.width;
+            const int H = _source.height;
+
+            int y = H - Y - 1;
+            if (_mirrorY)
+                y = H - y - 1;
+            if (!_decode || count <= 0 || y < 0 || y >= H)
+            {
+                zero(out, count);
+                return;
+            }
+
+            if (_pixelAspectRatio == 1.F && !_mirrorX)
+            {
+                // Render columns are image columns, so decode straight
+                // into the output.
+                const int x0 = std::max(X, 0);
+                const int x1 = std::min(X + count, W);
+                if (x0 >= x1)
+                {
+                    zero(out, count);
+                    return;
+                }
+                zero(out, x0 - X);
+                _decode(out + (x0 - X) * 4, _source, x0, y, x1 - x0);
+                zero(out + (x1 - X) * 4, X + count - x1);
+                return;
+            }
+
+            // Decode the span of image columns the render columns fall in
+            // and pick the pixels from it.
+            int first = _sourceX(X);
+            int last = _sourceX(X + count - 1);
+            if (first > last)
+                std::swap(first, last);
+            first = std::max(first, 0);
+            last = std::min(last, W - 1);
+            if (first > last)
+            {
+                zero(out, count);
+                return;
+            }
+
+            const int span = last - first + 1;
+            scratch.resize(static_cast<size_t>(span) * 4);
+            _decode(scratch.data(), _source, first, y, span);
+            for (int i = 0; i < count; ++i, out += 4)
+            {
+                const int x = _sourceX(X + i);
+                if (x < first || x > last)
+                {
+                    out[0] = out[1] = out[2] = out[3] = 0.F;
+                    continue;
+                }
+                std::memcpy(
+                    out, scratch.data() + (x - first) * 4, 4 * sizeof(float));
+            }
+        }
+
+    } // namespace pixel
+} // namespace mrv
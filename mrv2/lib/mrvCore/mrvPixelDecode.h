@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <tlCore/Image.h>
+
+namespace mrv
+{
+    using namespace tl;
+
+    namespace pixel
+    {
+        //! Plane layout and color information of an image, as needed by
+        //! the decoders.
+        struct Source
+        {
+            const uint8_t* data = nullptr;
+            int width = 0;
+            int height = 0;
+            image::VideoLevels videoLevels = image::VideoLevels::FullRange;
+            math::Vector4f yuvCoefficients;
+        };
+
+        /**
+         * Function decoding count pixels of a row of a Source, starting at
+         * column x, to RGBA floats.  Pixels must be inside the image.
+         */
+        using DecodeFunc = void (*)(
+            float* out, const Source& source, const int x, const int y,
+            const int count);
+
+        //! Return the decoder of a pixel type or nullptr if there is none.
+        DecodeFunc getDecoder(const image::PixelType type) noexcept;
+
+        /**
+         * Decode the raw pixels of an image as they are seen in the render
+         * buffer (flipped in Y, scaled by the pixel aspect ratio and
+         * mirrored).  The pixel type and the image information are looked
+         * up once, so whole rows are decoded without a per pixel switch.
+         */
+        class RowDecoder
+        {
+        public:
+            RowDecoder(
+                const std::shared_ptr<image::Image>& image,
+                const bool mirrorX, const bool mirrorY);
+
+            //! Whether the image has a decoder for its pixel type.
+            bool isValid() const noexcept { return _decode; }
+
+            /**
+             * Decode the pixels [X, X + count) of row Y of the render
+             * buffer to RGBA floats.  Pixels outside of the image are set
+             * to 0.
+             *
+             * @param scratch buffer reused between calls when the image
+             *                is scaled or mirrored in X.
+             */
+            void decode(
+                float* out, const int X, const int Y, const int count,
+                std::vector<float>& scratch) const noexcept;
+
+        private:
+            int _sourceX(const int X) const noexcept;
+
+            Source _source;
+            DecodeFunc _decode = nullptr;
+            float _pixelAspectRatio = 1.F;
+            bool _mirrorX = false;
+            bool _mirrorY = false;
+        };
+
+    } // namespace pixel
+} // namespace mrv
@@ -0,0 +1,498 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+#include "mrvCore/mrvColorAreaStats.h"
+#include "mrvCore/mrvScopes.h"
+#include "mrvCore/mrvThreadPool.h"
+
+namespace
+{
+    //! Minimum number of scanlines per tile.
+    const int kMinTileRows = 16;
+
+    const size_t kVectorscopeCells =
+        mrv::scopes::kVectorscopeSize * mrv::scopes::kVectorscopeSize;
+
+    //! Per tile partial results.
+    struct Tile
+    {
+        mrv::area::Partial area;
+
+        uint32_t red[256];
+        uint32_t green[256];
+        uint32_t blue[256];
+        uint32_t lumma[256];
+
+        std::vector<uint32_t> density;
+    };
+
+    inline uint8_t to8bits(const float v) noexcept
+    {
+        return static_cast<uint8_t>(std::clamp(v * 255.0F, 0.F, 255.F));
+    }
+
+    inline void histogramRow(const float* row, const int count, Tile& tile)
+    {
+        for (int i = 0; i < count; ++i, row += 4)
+        {
+            const uint8_t b = to8bits(row[0]);
+            const uint8_t g = to8bits(row[1]);
+            const uint8_t r = to8bits(row[2]);
+            ++tile.red[r];
+            ++tile.green[g];
+            ++tile.blue[b];
+            const unsigned lum = unsigned(r * 0.30f + g * 0.59f + b * 0.11f);
+            ++tile.lumma[lum];
+        }
+    }
+
+    //! Number of quantized hues of the vectorscope lookup table.
+    const int kHueSteps = 4096;
+
+    //! Offset from the center of the vectorscope grid, in cells, of a
+    //! fully saturated color of each quantized hue.
+    struct HueTable
+    {
+        float x[kHueSteps + 1];
+        float y[kHueSteps + 1];
+
+        HueTable()
+        {
+            using mrv::scopes::kVectorscopeSize;
+
+            constexpr double kDeg2Rad = 3.14159265358979323846 / 180.0;
+            const double radius = 0.375 * kVectorscopeSize;
+            for (int i = 0; i <= kHueSteps; ++i)
+            {
+                const double h = i / double(kHueSteps);
+                const double angle = (15.0 + h * 360.0) * kDeg2Rad;
+                x[i] = float(radius * std::sin(angle));
+                y[i] = float(radius * std::cos(angle));
+            }
+        }
+    };
+
+    const HueTable& hueTable()
+    {
+        static const HueTable table;
+        return table;
+    }
+
+    inline void vectorscopeRow(
+        const float* row, const int count, const HueTable& table, Tile& tile)
+    {
+        using namespace mrv::scopes;
+
+        constexpr float kCenter = kVectorscopeSize * 0.5F;
+        uint32_t* density = tile.density.data();
+        for (int i = 0; i < count; ++i, row += 4)
+        {
+            // The hue is taken from the BGRA pixel as if it was RGB, which
+            // is what the vectorscope graticule is laid out for.
+            const float r = std::clamp(row[0], 0.F, 1.F);
+            const float g = std::clamp(row[1], 0.F, 1.F);
+            const float b = std::clamp(row[2], 0.F, 1.F);
+            const float maxV = std::max(r, std::max(g, b));
+            const float minV = std::min(r, std::min(g, b));
+            const float spanV = maxV - minV;
+
+            float h = 0.F;
+            float s = 0.F;
+            if (spanV > 0.F)
+            {
+                s = spanV / maxV;
+                if (r == maxV)
+                    h = (g - b) / spanV;
+                else if (g == maxV)
+                    h = 2.F + (b - r) / spanV;
+                else
+                    h = 4.F + (r - g) / spanV;
+                if (h < 0.F)
+                    h += 6.F;
+                h /= 6.F;
+            }
+
+            const int hue = int(h * kHueSteps);
+            const int cx = std::clamp(
+                int(kCenter + s * table.x[hue]), 0, kVectorscopeSize - 1);
+            const int cy = std::clamp(
+                int(kCenter + s * table.y[hue]), 0, kVectorscopeSize - 1);
+            ++density[cx + cy * kVectorscopeSize];
+        }
+    }
+
+    //! Minimum number of columns per waveform tile.
+    const int kMinTileColumns = 8;
+
+    //! A decimated waveform samples at most this many scanlines...
+    const int kDecimatedRows = 540;
+
+    //! ...and this many pixels of each scanline per waveform column.
+    const int kDecimatedPixelsPerColumn = 2;
+
+    inline int toLevel(const float v) noexcept
+    {
+        using mrv::scopes::kWaveformLevels;
+        return static_cast<int>(
+            std::clamp(v, 0.F, 1.F) * (kWaveformLevels - 1) + 0.5F);
+    }
+} // namespace
+
+namespace mrv
+{
+    namespace scopes
+    {
+        void HistogramData::clear() noexcept
+        {
+            maxColor = maxLumma = 0.F;
+            memset(red, 0, sizeof(float) * 256);
+            memset(green, 0, sizeof(float) * 256);
+            memset(blue, 0, sizeof(float) * 256);
+            memset(lumma, 0, sizeof(float) * 256);
+        }
+
+        void VectorscopeData::clear() noexcept
+        {
+            maxDensity = 0;
+            density.assign(kVectorscopeCells, 0);
+        }
+
+        void process(
+            area::Info* info, HistogramData* histogram,
+            VectorscopeData* vectorscope, const math::Box2i& box,
+            const float* image, const math::Size2i& size,
+            const Options& options) noexcept
+        {
+            if (histogram)
+                histogram->clear();
+            if (vectorscope)
+                vectorscope->clear();
+
+            if (!image || size.w <= 0 || size.h <= 0)
+                return;
+            if (!info && !histogram && !vectorscope)
+                return;
+
+            const int minX = std::max(box.min.x, 0);
+            const int minY = std::max(box.min.y, 0);
+            const int maxX = std::min(box.max.x, size.w - 1);
+            const int maxY = std::min(box.max.y, size.h - 1);
+            if (maxX < minX || maxY < minY)
+                return;
+
+            const int count = maxX - minX + 1;
+            const size_t stride = static_cast<size_t>(size.w) * 4;
+
+            auto& pool = ThreadPool::instance();
+            const HueTable& table = hueTable();
+
+            // The vectorscope grid is big, so use one tile per thread.
+            const unsigned maxTiles = vectorscope ? pool.size() + 1 : 0;
+            std::vector<Tile> tiles(
+                pool.tileCount(minY, maxY + 1, kMinTileRows, maxTiles));
+
+            pool.parallel_rows(
+                minY, maxY + 1, kMinTileRows,
+                [&](int Y0, int Y1, unsigned index)
+                {
+                    Tile& tile = tiles[index];
+                    if (histogram)
+                    {
+                        memset(tile.red, 0, sizeof(tile.red));
+                        memset(tile.green, 0, sizeof(tile.green));
+                        memset(tile.blue, 0, sizeof(tile.blue));
+                        memset(tile.lumma, 0, sizeof(tile.lumma));
+                    }
+                    if (vectorscope)
+                        tile.density.assign(kVectorscopeCells, 0);
+
+                    for (int Y = Y0; Y < Y1; ++Y)
+                    {
+                        const float* row = image + Y * stride + minX * 4;
+                        if (info)
+                            area::accumulate(
+                                tile.area, row, count, options.hsvColorspace,
+                                options.brightnessType);
+                        if (histogram)
+                            histogramRow(row, count, tile);
+                        if (vectorscope)
+                            vectorscopeRow(row, count, table, tile);
+                    }
+                },
+                maxTiles);
+
+            if (info)
+            {
+                std::vector<area::Partial> partials;
+                partials.reserve(tiles.size());
+                for (const auto& tile : tiles)
+                    partials.push_back(tile.area);
+                area::merge(*info, partials);
+            }
+
+            if (histogram)
+            {
+                for (const auto& tile : tiles)
+                {
+                    for (int i = 0; i < 256; ++i)
+                    {
+                        histogram->red[i] += tile.red[i];
+                        histogram->green[i] += tile.green[i];
+                        histogram->blue[i] += tile.blue[i];
+                        histogram->lumma[i] += tile.lumma[i];
+                    }
+                }
+                for (int i = 0; i < 256; ++i)
+                {
+                    histogram->maxColor = std::max(
+                        {histogram->maxColor, histogram->red[i],
+                         histogram->green[i], histogram->blue[i]});
+                    histogram->maxLumma =
+                        std::max(histogram->maxLumma, histogram->lumma[i]);
+                }
+            }
+
+            if (vectorscope)
+            {
+                uint32_t* density = vectorscope->density.data();
+                for (const auto& tile : tiles)
+                {
+                    const uint32_t* tileDensity = tile.density.data();
+                    for (size_t i = 0; i < kVectorscopeCells; ++i)
+                        density[i] += tileDensity[i];
+                }
+                vectorscope->maxDensity =
+                    *std::max_element(density, density + kVectorscopeCells);
+            }
+        }
+
+        void WaveformData::clear() noexcept
+        {
+            columns = 0;
+            maxDensity = 0;
+            luma.clear();
+            red.clear();
+            green.clear();
+            blue.clear();
+        }
+
+        void waveform(
+            WaveformData& data, const float* pixels, const int width,
+            const int height, const WaveformOptions& options) noexcept
+        {
+            data.clear();
+            data.parade = options.parade;
+
+            if (!pixels || width <= 0 || height <= 0)
+                return;
+
+            const int columns =
+                std::min(width, std::max(1, options.maxColumns));
+            const size_t numCells =
+                static_cast<size_t>(columns) * kWaveformLevels;
+            data.columns = columns;
+            if (options.parade)
+            {
+                data.red.assign(numCells, 0);
+                data.green.assign(numCells, 0);
+                data.blue.assign(numCells, 0);
+            }
+            else
+            {
+                data.luma.assign(numCells, 0);
+            }
+
+            // Waveform column of each pixel.
+            std::vector<int> pixelColumn(width);
+            for (int x = 0; x < width; ++x)
+                pixelColumn[x] = static_cast<int>(
+                    static_cast<int64_t>(x) * columns / width);
+
+            uint32_t* luma = data.luma.data();
+            uint32_t* red = data.red.data();
+            uint32_t* green = data.green.data();
+            uint32_t* blue = data.blue.data();
+            const size_t stride = static_cast<size_t>(width) * 4;
+
+            auto& pool = ThreadPool::instance();
+            std::vector<uint32_t> maxima(
+                pool.tileCount(0, columns, kMinTileColumns), 0);
+
+            // Tiles are made of columns, not scanlines, so each tile owns
+            // its cells.
+            pool.parallel_rows(
+                0, columns, kMinTileColumns,
+                [&](int C0, int C1, unsigned index)
+                {
+                    // First pixel of columns C0 and C1.
+                    const int X0 = static_cast<int>(
+                        (static_cast<int64_t>(C0) * width + columns - 1) /
+                        columns);
+                    const int X1 = static_cast<int>(
+                        (static_cast<int64_t>(C1) * width + columns - 1) /
+                        columns);
+
+                    for (int Y = 0; Y < height; ++Y)
+                    {
+                        const float* pixel = pixels + Y * stride + X0 * 4;
+                        for (int X = X0; X < X1; ++X, pixel += 4)
+                        {
+                            const size_t column = pixelColumn[X];
+                            if (options.parade)
+                            {
+                                ++red[toLevel(pixel[2]) * columns + column];
+                                ++green[toLevel(pixel[1]) * columns + column];
+                                ++blue[toLevel(pixel[0]) * columns + column];
+                            }
+                            else
+                            {
+                                const float Y709 = pixel[2] * 0.2126F +
+                                                   pixel[1] * 0.7152F +
+                                                   pixel[0] * 0.0722F;
+                                ++luma[toLevel(Y709) * columns + column];
+                            }
+                        }
+                    }
+
+                    uint32_t maxDensity = 0;
+                    for (int level = 0; level < kWaveformLevels; ++level)
+                    {
+                        const size_t offset =
+                            static_cast<size_t>(level) * columns;
+                        for (int c = C0; c < C1; ++c)
+                        {
+                            if (options.parade)
+                                maxDensity = std::max(
+                                    {maxDensity, red[offset + c],
+                                     green[offset + c], blue[offset + c]});
+                            else
+                                maxDensity =
+                                    std::max(maxDensity, luma[offset + c]);
+                        }
+                    }
+                    maxima[index] = maxDensity;
+                });
+
+            for (const auto maxDensity : maxima)
+                data.maxDensity = std::max(data.maxDensity, maxDensity);
+        }
+
+        struct WaveformWorker::Private
+        {
+            //! True while a waveform is being calculated.
+            std::atomic<bool> busy{false};
+
+            //! Snapshot of the selection, tightly packed.
+            std::vector<float> pixels;
+            int width = 0;
+            int height = 0;
+
+            std::mutex mutex;
+            WaveformData result;
+            bool hasResult = false;
+        };
+
+        WaveformWorker::WaveformWorker() :
+            _p(std::make_shared<Private>())
+        {
+        }
+
+        WaveformWorker::~WaveformWorker() {}
+
+        bool WaveformWorker::request(
+            const math::Box2i& box, const float* image,
+            const math::Size2i& size, const WaveformOptions& options,
+            const std::function<void()>& done)
+        {
+            if (!image || size.w <= 0 || size.h <= 0)
+                return false;
+
+            const int minX = std::max(box.min.x, 0);
+            const int minY = std::max(box.min.y, 0);
+            const int maxX = std::min(box.max.x, size.w - 1);
+            const int maxY = std::min(box.max.y, size.h - 1);
+            if (maxX < minX || maxY < minY)
+                return false;
+
+            // The shared state is kept alive by the task, so the worker
+            // can be deleted while a waveform is being calculated.
+            std::shared_ptr<Private> p = _p;
+            if (p->busy.exchange(true))
+                return false;
+
+            const int W = maxX - minX + 1;
+            const int H = maxY - minY + 1;
+            int stepX = 1;
+            int stepY = 1;
+            if (options.decimate)
+            {
+                const int columns =
+                    std::min(W, std::max(1, options.maxColumns));
+                stepX = std::max(1, W / (columns * kDecimatedPixelsPerColumn));
+                stepY = (H + kDecimatedRows - 1) / kDecimatedRows;
+            }
+            p->width = (W + stepX - 1) / stepX;
+            p->height = (H + stepY - 1) / stepY;
+            p->pixels.resize(static_cast<size_t>(p->width) * p->height * 4);
+
+            // The render buffer is only mapped while drawing, so the
+            // snapshot is taken now.  It is memory bound, so split it too.
+            const size_t stride = static_cast<size_t>(size.w) * 4;
+            auto& pool = ThreadPool::instance();
+            pool.parallel_rows(
+                0, p->height, kMinTileRows,
+                [&](int Y0, int Y1, unsigned)
+                {
+                    for (int Y = Y0; Y < Y1; ++Y)
+                    {
+                        const float* src =
+                            image + (minY + Y * stepY) * stride + minX * 4;
+                        float* dst = p->pixels.data() +
+                                     static_cast<size_t>(Y) * p->width * 4;
+                        if (stepX == 1)
+                        {
+                            memcpy(dst, src, sizeof(float) * 4 * p->width);
+                            continue;
+                        }
+                        for (int X = 0; X < p->width;
+                             ++X, src += stepX * 4, dst += 4)
+                            memcpy(dst, src, sizeof(float) * 4);
+                    }
+                });
+
+            pool.async(
+                [p, options, done]
+                {
+                    WaveformData data;
+                    waveform(
+                        data, p->pixels.data(), p->width, p->height, options);
+                    {
+                        std::unique_lock<std::mutex> lock(p->mutex);
+                        std::swap(p->result, data);
+                        p->hasResult = true;
+                    }
+                    p->busy = false;
+                    if (done)
+                        done();
+                });
+            return true;
+        }
+
+        bool WaveformWorker::result(WaveformData& data)
+        {
+            std::unique_lock<std::mutex> lock(_p->mutex);
+            if (!_p->hasResult)
+                return false;
+            std::swap(data, _p->result);
+            _p->hasResult = false;
+            return true;
+        }
+    } // namespace scopes
+} // namespace mrv
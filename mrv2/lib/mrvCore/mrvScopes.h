@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <tlCore/Box.h>
+#include <tlCore/Size.h>
+
+#include "mrvCore/mrvColorSpaces.h"
+
+#include "mrvFl/mrvColorAreaInfo.h"
+
+namespace mrv
+{
+    namespace scopes
+    {
+        //! Histogram bins of a selection, quantized to 8 bits.
+        struct HistogramData
+        {
+            float red[256];
+            float green[256];
+            float blue[256];
+            float lumma[256];
+
+            float maxColor = 0.F;
+            float maxLumma = 0.F;
+
+            void clear() noexcept;
+        };
+
+        //! Size in cells of the square vectorscope density grid.
+        constexpr int kVectorscopeSize = 256;
+
+        /**
+         * Vectorscope density grid.  Each cell counts the pixels whose
+         * hue/saturation fall on it.  The center of the grid is
+         * saturation 0 and saturation 1 lies at 0.75 of the radius.
+         */
+        struct VectorscopeData
+        {
+            std::vector<uint32_t> density;
+            uint32_t maxDensity = 0;
+
+            void clear() noexcept;
+        };
+
+        struct Options
+        {
+            //! color::Space for the color area hsv channels.
+            int hsvColorspace = color::kHSV;
+
+            //! Brightness type for the color area hsv.a channel.
+            BrightnessType brightnessType = kAsLuminance;
+        };
+
+        /**
+         * Single pass scopes pipeline.  It walks the selection of the
+         * mapped BGRA float buffer once, in tiles of scanlines run on the
+         * global ThreadPool, and fills the color area statistics, the
+         * histogram and the vectorscope that were requested.  Pass
+         * nullptr for the scopes that are not shown.
+         *
+         * @param info        Color area statistics to fill.
+         * @param histogram   Histogram to fill.
+         * @param vectorscope Vectorscope to fill.
+         * @param box         Selection in pixels (inclusive, sorted).
+         * @param image       BGRA float buffer, as read back from OpenGL.
+         * @param size        Size of the image buffer.
+         * @param options     Color area options.
+         */
+        void process(
+            area::Info* info, HistogramData* histogram,
+            VectorscopeData* vectorscope, const math::Box2i& box,
+            const float* image, const math::Size2i& size,
+            const Options& options) noexcept;
+
+        //! Number of intensity levels of each waveform column.
+        constexpr int kWaveformLevels = 256;
+
+        /**
+         * Waveform density.  Each column of the selection (binned down to
+         * at most WaveformOptions::maxColumns) counts how many pixels fall
+         * on each intensity level.  Counts are stored level by level, so
+         * cell (column, level) is at level * columns + column.  Only luma
+         * is filled for the luma waveform and only red, green and blue for
+         * the RGB parade.
+         */
+        struct WaveformData
+        {
+            int columns = 0;
+            bool parade = false;
+
+            std::vector<uint32_t> luma;
+            std::vector<uint32_t> red;
+            std::vector<uint32_t> green;
+            std::vector<uint32_t> blue;
+
+            uint32_t maxDensity = 0;
+
+            void clear() noexcept;
+        };
+
+        struct WaveformOptions
+        {
+            //! RGB parade instead of luma waveform.
+            bool parade = false;
+
+            //! Maximum number of columns.  Wider selections are binned.
+            int maxColumns = 512;
+
+            //! Sample only a subset of the scanlines and pixels of big
+            //! selections, so the waveform keeps up with UHD playback.
+            bool decimate = true;
+        };
+
+        /**
+         * Calculate the waveform of a tightly packed BGRA float image.
+         * Columns are split in tiles run on the global ThreadPool, so each
+         * tile owns its cells and no merging is needed.
+         */
+        void waveform(
+            WaveformData& data, const float* pixels, const int width,
+            const int height, const WaveformOptions& options) noexcept;
+
+        /**
+         * Asynchronous waveform calculation.  request() takes a snapshot
+         * of the selection (decimated when asked to) while the render
+         * buffer is mapped and calculates the waveform on the ThreadPool,
+         * off the FLTK thread.  While a waveform is being calculated new
+         * requests are dropped, so a slow waveform never stalls playback.
+         */
+        class WaveformWorker
+        {
+        public:
+            WaveformWorker();
+            ~WaveformWorker();
+
+            /**
+             * Start calculating the waveform of a selection.
+             *
+             * @param box     Selection in pixels (inclusive, sorted).
+             * @param image   BGRA float buffer, as read back from OpenGL.
+             * @param size    Size of the image buffer.
+             * @param options Waveform options.
+             * @param done    Called from the worker thread when finished.
+             *
+             * @return false if the previous waveform is not done yet.
+             */
+            bool request(
+                const math::Box2i& box, const float* image,
+                const math::Size2i& size, const WaveformOptions& options,
+                const std::function<void()>& done);
+
+            //! Get the last waveform calculated.  Returns false if there
+            //! is no new waveform since the last call.
+            bool result(WaveformData& data);
+
+        private:
+            struct Private;
+            std::shared_ptr<Private> _p;
+        };
+    } // namespace scopes
+} // namespace mrv
@@ -2,12 +2,78 @@
 // mrv2
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
+#include <algorithm>
+#include <unordered_map>
+
+#include "mrvCore/mrvSequence.h"
+
 namespace
 {
-    const char* kModule = "seq";
-}
+    int leadingZeros(const std::string& number)
+    {
+        int out = 0;
+        for (const char c : number)
+        {
+            if (c != '0')
+                break;
+            ++out;
+        }
+        return out;
+    }
+} // namespace
 
 namespace mrv
 {
 
+    std::vector<SequenceRange> collapseSequences(const SequenceList& frames)
+    {
+        // Group the frames by name, so the names are compared once per
+        // frame instead of on every comparison of the sort.
+        std::unordered_map<std::string, size_t> groupIndex;
+        std::vector<std::vector<const Sequence*> > groups;
+        for (const auto& frame : frames)
+        {
+            std::string key = frame.root;
+            key += '\0';
+            key += frame.ext;
+            key += '\0';
+            key += frame.view;
+            auto i = groupIndex.find(key);
+            if (i == groupIndex.end())
+            {
+                i = groupIndex.emplace(key, groups.size()).first;
+                groups.emplace_back();
+            }
+            groups[i->second].push_back(&frame);
+        }
+
+        std::vector<std::pair<std::string, size_t> > order(
+            groupIndex.begin(), groupIndex.end());
+        std::sort(order.begin(), order.end());
+
+        std::vector<SequenceRange> out;
+        for (const auto& i : order)
+        {
+            auto& group = groups[i.second];
+            std::sort(
+                group.begin(), group.end(),
+                [](const Sequence* a, const Sequence* b)
+                { return a->frame < b->frame; });
+
+            // A change in padding starts a new sequence, except for the
+            // zero lost when going from 0099 to 0100.
+            int zeros = -1;
+            for (const Sequence* frame : group)
+            {
+                const int z = leadingZeros(frame->number);
+                if (zeros < 0 || (zeros != z && z != zeros - 1))
+                    out.push_back({*frame, *frame});
+                else
+                    out.back().last = *frame;
+                zeros = z;
+            }
+        }
+        return out;
+    }
+
 } // namespace mrv
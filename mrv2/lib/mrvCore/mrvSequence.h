@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,9 @@ namespace mrv
         std::string number;
         std::string view;
         std::string ext;
+
+        //! Frame number, parsed once from number.
+        int64_t frame = 0;
     };
 
     typedef std::vector< Sequence > SequenceList;
@@ -42,10 +46,26 @@ namespace mrv
             else if (a.view > b.view)
                 return false;
 
-            if (atoi(a.number.c_str()) < atoi(b.number.c_str()))
-                return true;
-            return false;
+            return a.frame < b.frame;
         }
     };
 
+    //! The first and last frames of a sequence.
+    struct SequenceRange
+    {
+        Sequence first;
+        Sequence last;
+    };
+
+    /**
+     * Sort the frames found in a directory and collapse them into
+     * sequences in a single pass.  Frames are grouped by root, view and
+     * extension and only the frame numbers are sorted within each group.
+     *
+     * @param frames Frames with their frame number parsed.
+     *
+     * @return the sequences, ordered by root, extension and view.
+     */
+    std::vector<SequenceRange> collapseSequences(const SequenceList& frames);
+
 } // namespace mrv
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "mrvCore/mrvThreadPool.h"
+
+namespace
+{
+    //! Shared state of a parallel_for call.  It is reference counted as
+    //! helper tasks may still sit in the queue when the caller returns.
+    struct ForState
+    {
+        std::function<void(unsigned)> func;
+        unsigned count = 0;
+        std::atomic<unsigned> next{0};
+        std::atomic<unsigned> done{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        void work()
+        {
+            unsigned index;
+            while ((index = next.fetch_add(1)) < count)
+            {
+                func(index);
+                if (done.fetch_add(1) + 1 == count)
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.notify_all();
+                }
+            }
+        }
+    };
+} // namespace
+
+namespace mrv
+{
+    ThreadPool::ThreadPool()
+    {
+        unsigned numThreads = std::thread::hardware_concurrency();
+        if (numThreads < 2)
+            numThreads = 2;
+        // Leave one core for the FLTK thread, which takes part in the work.
+        --numThreads;
+        m_threads.reserve(numThreads);
+        for (unsigned i = 0; i < numThreads; ++i)
+            m_threads.emplace_back([this] { _run(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (auto& thread : m_threads)
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+    }
+
+    ThreadPool& ThreadPool::instance()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    void ThreadPool::_run()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+                if (m_stop && m_tasks.empty())
+                    return;
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    void ThreadPool::async(std::function<void()> task)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_cv.notify_one();
+    }
+
+    void ThreadPool::parallel_for(
+        const unsigned count, const std::function<void(unsigned)>& func)
+    {
+        if (count == 0)
+            return;
+        if (count == 1)
+        {
+            func(0);
+            return;
+        }
+
+        auto state = std::make_shared<ForState>();
+        state->func = func;
+        state->count = count;
+
+        const unsigned helpers =
+            std::min(count - 1, static_cast<unsigned>(m_threads.size()));
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            for (unsigned i = 0; i < helpers; ++i)
+                m_tasks.push_back([state] { state->work(); });
+        }
+        m_cv.notify_all();
+
+        state->work();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->cv.wait(lock, [&state] { return state->done == state->count; });
+    }
+
+    unsigned ThreadPool::tileCount(
+        const int start, const int end, const int minRows,
+        const unsigned maxTiles) const
+    {
+        const int rows = end - start;
+        if (rows <= 0)
+            return 0;
+        const int maxRowTiles = std::max(1, rows / std::max(1, minRows));
+        // A few more tiles than threads so uneven tiles balance out.
+        int numTiles = static_cast<int>(m_threads.size() + 1) * 4;
+        if (maxTiles > 0)
+            numTiles = std::min(numTiles, static_cast<int>(maxTiles));
+        return static_cast<unsigned>(std::min(maxRowTiles, numTiles));
+    }
+
+    unsigned ThreadPool::parallel_rows(
+        const int start, const int end, const int minRows,
+        const std::function<void(int, int, unsigned)>& func,
+        const unsigned maxTiles)
+    {
+        const unsigned tiles = tileCount(start, end, minRows, maxTiles);
+        if (tiles == 0)
+            return 0;
+
+        const int rows = end - start;
+        parallel_for(
+            tiles,
+            [=, &func](unsigned tile)
+            {
+                const int Y0 = start + rows * tile / tiles;
+                const int Y1 = start + rows * (tile + 1) / tiles;
+                func(Y0, Y1, tile);
+            });
+        return tiles;
+    }
+
+} // namespace mrv
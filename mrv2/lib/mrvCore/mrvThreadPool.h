@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mrv
+{
+    /**
+     * A small pool of worker threads used to split CPU bound image work
+     * (color area statistics, scopes, etc) in tiles.
+     *
+     * The pool is created lazily on first use and lives until the
+     * application exits.
+     */
+    class ThreadPool
+    {
+    public:
+        ~ThreadPool();
+
+        //! Return the global thread pool.
+        static ThreadPool& instance();
+
+        //! Number of worker threads in the pool.
+        unsigned size() const noexcept { return m_threads.size(); }
+
+        /**
+         * Run func(index) for every index in [0, count) and wait for all
+         * of them to finish.  The calling thread takes part in the work,
+         * so this is safe to call from a worker thread too.
+         *
+         * @param count number of tasks.
+         * @param func  task to run for each index.
+         */
+        void parallel_for(
+            const unsigned count, const std::function<void(unsigned)>& func);
+
+        /**
+         * Split the rows [start, end) in contiguous tiles of at least
+         * minRows and run func(tileStart, tileEnd, tileIndex) on them.
+         * If maxTiles is not 0, no more than maxTiles tiles are used (for
+         * callers with big per-tile partial results).
+         *
+         * @return number of tiles used, so callers can size their
+         *         per-tile partial results with tileCount().
+         */
+        unsigned parallel_rows(
+            const int start, const int end, const int minRows,
+            const std::function<void(int, int, unsigned)>& func,
+            const unsigned maxTiles = 0);
+
+        //! Number of tiles parallel_rows() will use for a range of rows.
+        unsigned tileCount(
+            const int start, const int end, const int minRows,
+            const unsigned maxTiles = 0) const;
+
+        //! Queue a task to be run on a worker thread and return immediately.
+        void async(std::function<void()> task);
+
+    protected:
+        ThreadPool();
+
+        void _run();
+
+        std::vector< std::thread > m_threads;
+        std::deque< std::function<void()> > m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        bool m_stop = false;
+    };
+
+} // namespace mrv
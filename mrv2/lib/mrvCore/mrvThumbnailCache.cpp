@@ -0,0 +1,611 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+namespace fs = std::filesystem;
+
+#include <tlCore/StringFormat.h>
+
+#include "mrvCore/mrvHash.h"
+#include "mrvCore/mrvHome.h"
+#include "mrvCore/mrvThumbnailCache.h"
+
+#include "mrvFl/mrvIO.h"
+
+namespace
+{
+    const char* kModule = "thumbs";
+
+    const char kMagic[4] = {'M', 'R', 'V', 'T'};
+    const uint32_t kVersion = 2;
+    const char* kExtension = ".thumb";
+
+    //! Time between checks of the requests sent to the thumbnail system.
+    const std::chrono::milliseconds kPollTime(5);
+
+    //! Most bytes of free buffers kept in the pool, of all sizes.
+    const size_t kMaxPooledBytes = 64 * 1024 * 1024;
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t width;
+        uint32_t height;
+        uint32_t keySize;
+    };
+
+    struct BufferPool
+    {
+        struct Buffer
+        {
+            size_t size = 0;
+            std::unique_ptr<uint8_t[]> data;
+        };
+
+        //! Free buffers, most recently returned first.
+        std::list<Buffer> buffers;
+
+        //! Free buffers of each size, oldest first.
+        std::map<size_t, std::deque<std::list<Buffer>::iterator> > sizes;
+
+        size_t bytes = 0;
+        std::mutex mutex;
+
+        void evictOldest()
+        {
+            auto i = std::prev(buffers.end());
+            auto j = sizes.find(i->size);
+            j->second.pop_front();
+            if (j->second.empty())
+                sizes.erase(j);
+            bytes -= i->size;
+            buffers.erase(i);
+        }
+    };
+
+    // Never destroyed, as pixels may be released after static
+    // destructors ran.
+    BufferPool& bufferPool()
+    {
+        static BufferPool* pool = new BufferPool;
+        return *pool;
+    }
+
+    std::string hashKey(const std::string& key)
+    {
+        return mrv::hashToHex(mrv::hash(key));
+    }
+} // namespace
+
+namespace mrv
+{
+    namespace
+    {
+        //! Key of a thumbnail, or an empty string if the file cannot be
+        //! stat'ed.
+        std::string getKey(
+            const file::Path& path, const int height,
+            const otime::RationalTime& time, const io::Options& options)
+        {
+            // Sequences are stamped with the frame of the thumbnail.
+            std::string fileName = path.get();
+            if (path.isSequence() && time::isValid(time))
+            {
+                const std::string frame =
+                    path.get(static_cast<int>(std::llround(time.value())));
+                std::error_code ec;
+                if (fs::is_regular_file(frame, ec))
+                    fileName = frame;
+            }
+
+            std::error_code ec;
+            const auto size = fs::file_size(fileName, ec);
+            if (ec)
+                return std::string();
+            const auto mtime = fs::last_write_time(fileName, ec);
+            if (ec)
+                return std::string();
+
+            std::string out = string::Format("{0}|{1}|{2}|{3}|{4}")
+                                  .arg(path.get())
+                                  .arg(size)
+                                  .arg(mtime.time_since_epoch().count())
+                                  .arg(time)
+                                  .arg(height);
+            for (const auto& i : options)
+            {
+                if (i.first != "ClearCache")
+                    out += "|" + i.first + "=" + i.second;
+            }
+            return out;
+        }
+
+        std::shared_ptr<ThumbnailPixels>
+        readThumbnail(const std::string& fileName, const std::string& key)
+        {
+            std::ifstream ifs(fileName, std::ios::binary);
+            if (!ifs.is_open())
+                return nullptr;
+
+            Header header;
+            ifs.read(reinterpret_cast<char*>(&header), sizeof(Header));
+            if (!ifs || memcmp(header.magic, kMagic, 4) != 0 ||
+                header.version != kVersion || header.keySize != key.size() ||
+                header.width == 0 || header.height == 0)
+                return nullptr;
+
+            std::string fileKey(header.keySize, 0);
+            ifs.read(fileKey.data(), fileKey.size());
+            if (!ifs || fileKey != key)
+                return nullptr;
+
+            // The pixels are stored flipped, so they are read straight
+            // into the buffer FLTK draws.
+            auto out = ThumbnailPixels::create(header.width, header.height);
+            ifs.read(
+                reinterpret_cast<char*>(out->getData()), out->getByteCount());
+            if (!ifs)
+                return nullptr;
+            return out;
+        }
+
+        std::shared_ptr<ThumbnailPixels>
+        toPixels(const std::shared_ptr<image::Image>& image)
+        {
+            if (!image || image->getPixelType() != image::PixelType::RGBA_U8)
+                return nullptr;
+
+            const int w = image->getWidth();
+            const int h = image->getHeight();
+            auto out = ThumbnailPixels::create(w, h);
+            uint8_t* d = out->getData();
+            const uint8_t* s = image->getData();
+            for (int y = 0; y < h; ++y)
+            {
+                memcpy(d + (h - 1 - y) * w * 4, s + y * w * 4, w * 4);
+            }
+            return out;
+        }
+    } // namespace
+
+    ThumbnailPixels::~ThumbnailPixels()
+    {
+        if (!_data || !_pooled)
+            return;
+        const size_t size = getByteCount();
+        if (size > kMaxPooledBytes)
+            return;
+        auto& pool = bufferPool();
+        std::unique_lock<std::mutex> lock(pool.mutex);
+        while (pool.bytes + size > kMaxPooledBytes)
+            pool.evictOldest();
+        pool.buffers.push_front({size, std::move(_data)});
+        pool.sizes[size].push_back(pool.buffers.begin());
+        pool.bytes += size;
+    }
+
+    std::shared_ptr<ThumbnailPixels>
+    ThumbnailPixels::create(
+        const int width, const int height, const bool pooled)
+    {
+        auto out = std::shared_ptr<ThumbnailPixels>(new ThumbnailPixels);
+        out->_width = width;
+        out->_height = height;
+        out->_pooled = pooled;
+        if (pooled)
+        {
+            auto& pool = bufferPool();
+            std::unique_lock<std::mutex> lock(pool.mutex);
+            auto i = pool.sizes.find(out->getByteCount());
+            if (i != pool.sizes.end())
+            {
+                auto buffer = i->second.back();
+                i->second.pop_back();
+                if (i->second.empty())
+                    pool.sizes.erase(i);
+                out->_data = std::move(buffer->data);
+                pool.bytes -= buffer->size;
+                pool.buffers.erase(buffer);
+            }
+        }
+        if (!out->_data)
+            out->_data.reset(new uint8_t[out->getByteCount()]);
+        return out;
+    }
+
+    void ThumbnailPixels::releasePool()
+    {
+        auto& pool = bufferPool();
+        std::unique_lock<std::mutex> lock(pool.mutex);
+        pool.buffers.clear();
+        pool.sizes.clear();
+        pool.bytes = 0;
+    }
+
+    ThumbnailImage::ThumbnailImage(
+        const std::shared_ptr<ThumbnailPixels>& pixels) :
+        Fl_RGB_Image(
+            pixels->getData(), pixels->getWidth(), pixels->getHeight(), 4),
+        _pixels(pixels)
+    {
+    }
+
+    ThumbnailImage::ThumbnailImage(
+        const std::shared_ptr<ThumbnailPixels>& pixels, const int x,
+        const int y, const int w, const int h) :
+        Fl_RGB_Image(
+            pixels->getData() + (y * size_t(pixels->getWidth()) + x) * 4, w, h,
+            4, pixels->getWidth() * 4),
+        _pixels(pixels)
+    {
+    }
+
+    struct ThumbnailCache::Private
+    {
+        std::string directory;
+        uint64_t maxSize = 0;
+
+        //! Size of the cache on disk.  Other instances write to it too,
+        //! so it is only exact after a scan of the directory.
+        uint64_t size = 0;
+        bool scanned = false;
+
+        //! Whether the thread should scan the directory and remove the
+        //! least recently used thumbnails if the cache is too big.
+        bool trim = false;
+
+        struct Job
+        {
+            uint64_t id = 0;
+            std::weak_ptr<ui::ThumbnailSystem> thumbnailSystem;
+            file::Path path;
+            int height = 0;
+            otime::RationalTime time = time::invalidTime;
+            io::Options options;
+            std::string key;
+            ui::ThumbnailRequest request;
+            std::promise<std::shared_ptr<ThumbnailPixels> > promise;
+        };
+        uint64_t jobId = 0;
+        std::deque<Job> jobs;
+        std::set<uint64_t> cancelled;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::thread thread;
+        bool stop = false;
+    };
+
+    ThumbnailCache::ThumbnailCache() :
+        _p(new Private)
+    {
+        _p->directory = prefspath() + "thumbnails/";
+    }
+
+    ThumbnailCache::~ThumbnailCache()
+    {
+        TLRENDER_P();
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.stop = true;
+        }
+        p.cv.notify_all();
+        if (p.thread.joinable())
+            p.thread.join();
+    }
+
+    ThumbnailCache& ThumbnailCache::instance()
+    {
+        static ThumbnailCache cache;
+        return cache;
+    }
+
+    void ThumbnailCache::setMaxSize(const uint64_t bytes)
+    {
+        TLRENDER_P();
+
+        if (bytes > 0)
+        {
+            std::error_code ec;
+            fs::create_directories(p.directory, ec);
+            if (ec)
+            {
+                LOG_ERROR(string::Format(_("Cannot create {0}: {1}"))
+                              .arg(p.directory)
+                              .arg(ec.message()));
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.maxSize = 0;
+                return;
+            }
+        }
+
+        // The directory is scanned by the thread of the cache, so the user
+        // interface does not wait for the disk.
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.maxSize = bytes;
+            if (0 == bytes || (p.scanned && p.size <= bytes))
+                return;
+            p.trim = true;
+            if (!p.thread.joinable())
+                p.thread = std::thread([this] { _run(); });
+        }
+        p.cv.notify_one();
+    }
+
+    uint64_t ThumbnailCache::getMaxSize() const
+    {
+        return _p->maxSize;
+    }
+
+    ThumbnailRequest ThumbnailCache::getThumbnail(
+        const std::shared_ptr<ui::ThumbnailSystem>& thumbnailSystem,
+        const file::Path& path, const int height,
+        const otime::RationalTime& time, const io::Options& options)
+    {
+        TLRENDER_P();
+
+        Private::Job job;
+        job.thumbnailSystem = thumbnailSystem;
+        job.path = path;
+        job.height = height;
+        job.time = time;
+        job.options = options;
+
+        ThumbnailRequest out;
+        out.future = job.promise.get_future();
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            out.id = job.id = p.jobId++;
+            p.jobs.push_back(std::move(job));
+            if (!p.thread.joinable())
+                p.thread = std::thread([this] { _run(); });
+        }
+        p.cv.notify_one();
+        return out;
+    }
+
+    void ThumbnailCache::cancelRequests(const std::vector<uint64_t>& ids)
+    {
+        TLRENDER_P();
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.cancelled.insert(ids.begin(), ids.end());
+        }
+        p.cv.notify_one();
+    }
+
+    void ThumbnailCache::_run()
+    {
+        TLRENDER_P();
+
+        // Requests sent to the thumbnail system.
+        std::list<Private::Job> waiting;
+
+        while (true)
+        {
+            std::deque<Private::Job> jobs;
+            std::set<uint64_t> cancelled;
+            uint64_t maxSize = 0;
+            bool trim = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                auto wake = [&p]
+                {
+                    return p.stop || p.trim || !p.jobs.empty() ||
+                           !p.cancelled.empty();
+                };
+                if (waiting.empty())
+                    p.cv.wait(lock, wake);
+                else
+                    p.cv.wait_for(lock, kPollTime, wake);
+                if (p.stop)
+                    break;
+                std::swap(jobs, p.jobs);
+                std::swap(cancelled, p.cancelled);
+                maxSize = p.maxSize;
+                trim = p.trim && maxSize > 0;
+                p.trim = false;
+            }
+
+            for (auto& job : jobs)
+            {
+                if (cancelled.count(job.id))
+                {
+                    job.promise.set_value(nullptr);
+                    continue;
+                }
+
+                if (maxSize > 0)
+                    job.key = getKey(
+                        job.path, job.height, job.time, job.options);
+
+                // Clearing the cache makes a new thumbnail, which replaces
+                // the one on disk.
+                if (!job.key.empty() &&
+                    job.options.find("ClearCache") == job.options.end())
+                {
+                    const std::string fileName =
+                        p.directory + hashKey(job.key) + kExtension;
+                    if (auto pixels = readThumbnail(fileName, job.key))
+                    {
+                        std::error_code ec;
+                        fs::last_write_time(
+                            fileName, fs::file_time_type::clock::now(), ec);
+                        job.promise.set_value(std::move(pixels));
+                        continue;
+                    }
+                }
+
+                auto thumbnailSystem = job.thumbnailSystem.lock();
+                if (!thumbnailSystem)
+                {
+                    job.promise.set_value(nullptr);
+                    continue;
+                }
+                job.request = thumbnailSystem->getThumbnail(
+                    job.path, job.height, job.time, job.options);
+                waiting.push_back(std::move(job));
+            }
+
+            for (auto i = waiting.begin(); i != waiting.end();)
+            {
+                if (cancelled.count(i->id))
+                {
+                    if (auto thumbnailSystem = i->thumbnailSystem.lock())
+                        thumbnailSystem->cancelRequests({i->request.id});
+                    i->promise.set_value(nullptr);
+                    i = waiting.erase(i);
+                    continue;
+                }
+                if (i->request.future.wait_for(std::chrono::seconds(0)) !=
+                    std::future_status::ready)
+                {
+                    ++i;
+                    continue;
+                }
+
+                std::shared_ptr<ThumbnailPixels> pixels;
+                try
+                {
+                    pixels = toPixels(i->request.future.get());
+                }
+                catch (const std::exception&)
+                {
+                }
+                if (pixels && !i->key.empty())
+                    _write(i->key, *pixels);
+                i->promise.set_value(pixels);
+                i = waiting.erase(i);
+            }
+
+            // Trimming after the requests are served, as it can take a
+            // while on a big cache.
+            if (trim)
+                _trim(maxSize);
+        }
+
+        for (auto& job : waiting)
+            job.promise.set_value(nullptr);
+    }
+
+    void ThumbnailCache::_write(
+        const std::string& key, const ThumbnailPixels& pixels)
+    {
+        TLRENDER_P();
+
+        // Write under a name of our own and rename, so other instances
+        // never read a partial file.
+        const std::string fileName = p.directory + hashKey(key) + kExtension;
+        const auto now = std::chrono::steady_clock::now();
+        const std::string tmp = string::Format("{0}.{1}.tmp")
+                                    .arg(fileName)
+                                    .arg(now.time_since_epoch().count());
+        {
+            std::ofstream ofs(tmp, std::ios::binary);
+            if (!ofs.is_open())
+                return;
+
+            Header header;
+            memcpy(header.magic, kMagic, 4);
+            header.version = kVersion;
+            header.width = pixels.getWidth();
+            header.height = pixels.getHeight();
+            header.keySize = key.size();
+            ofs.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            ofs.write(key.data(), key.size());
+            ofs.write(
+                reinterpret_cast<const char*>(pixels.getData()),
+                pixels.getByteCount());
+            if (!ofs)
+            {
+                ofs.close();
+                std::error_code ec;
+                fs::remove(tmp, ec);
+                return;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tmp, fileName, ec);
+        if (ec)
+        {
+            fs::remove(tmp, ec);
+            return;
+        }
+
+        // The cache is trimmed on the next loop of the thread.
+        std::unique_lock<std::mutex> lock(p.mutex);
+        p.size += sizeof(Header) + key.size() + pixels.getByteCount();
+        if (p.maxSize > 0 && p.size > p.maxSize)
+            p.trim = true;
+    }
+
+    void ThumbnailCache::_trim(const uint64_t maxSize)
+    {
+        TLRENDER_P();
+
+        // The directory is scanned without the lock, so requests are not
+        // blocked meanwhile.  Only this thread writes to the cache.
+
+        struct Entry
+        {
+            fs::path path;
+            fs::file_time_type time;
+            uint64_t size;
+        };
+        std::vector<Entry> entries;
+        uint64_t size = 0;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(p.directory, ec))
+        {
+            if (entry.path().extension() != kExtension)
+                continue;
+            Entry e;
+            e.path = entry.path();
+            e.time = entry.last_write_time(ec);
+            e.size = entry.file_size(ec);
+            if (ec)
+                continue;
+            size += e.size;
+            entries.push_back(e);
+        }
+
+        // Remove the least recently used thumbnails down to 3/4 of the
+        // maximum size, so the directory is not scanned on every add.
+        std::sort(
+            entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.time < b.time; });
+        if (size > maxSize)
+        {
+            const uint64_t target = maxSize / 4 * 3;
+            for (const auto& entry : entries)
+            {
+                if (size <= target)
+                    break;
+                if (fs::remove(entry.path, ec))
+                    size -= entry.size;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(p.mutex);
+        p.size = size;
+        p.scanned = true;
+    }
+
+} // namespace mrv
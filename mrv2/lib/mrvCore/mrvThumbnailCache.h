@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <tlUI/ThumbnailSystem.h>
+
+#include <tlCore/Util.h>
+
+#include <FL/Fl_Image.H>
+
+namespace mrv
+{
+    using namespace tl;
+
+    /**
+     * The RGBA8 pixels of a thumbnail, with the rows flipped as FLTK
+     * expects them.  Buffers return to a pool when the pixels are
+     * destroyed and are reused by pixels of the same size.  The pool holds
+     * a bounded number of bytes, and drops its least recently returned
+     * buffers first.
+     */
+    class ThumbnailPixels
+    {
+    public:
+        ~ThumbnailPixels();
+
+        //! Create pixels, reusing a buffer of the pool if there is one.
+        //! Pixels that are not pooled, like the pages of an atlas, neither
+        //! take their buffer from the pool nor return it.
+        static std::shared_ptr<ThumbnailPixels>
+        create(const int width, const int height, const bool pooled = true);
+
+        //! Free the buffers kept for reuse.
+        static void releasePool();
+
+        int getWidth() const { return _width; }
+        int getHeight() const { return _height; }
+        size_t getByteCount() const { return _width * _height * 4; }
+
+        uint8_t* getData() { return _data.get(); }
+        const uint8_t* getData() const { return _data.get(); }
+
+    private:
+        ThumbnailPixels() = default;
+
+        int _width = 0;
+        int _height = 0;
+        bool _pooled = true;
+        std::unique_ptr<uint8_t[]> _data;
+    };
+
+    //! An FLTK image drawing thumbnail pixels without copying them.
+    class ThumbnailImage : public Fl_RGB_Image
+    {
+    public:
+        ThumbnailImage(const std::shared_ptr<ThumbnailPixels>&);
+
+        //! Draw a rectangle of the pixels, like a cell of an atlas.
+        ThumbnailImage(
+            const std::shared_ptr<ThumbnailPixels>&, const int x, const int y,
+            const int w, const int h);
+
+    private:
+        std::shared_ptr<ThumbnailPixels> _pixels;
+    };
+
+    //! A thumbnail request.
+    struct ThumbnailRequest
+    {
+        uint64_t id = 0;
+        std::future<std::shared_ptr<ThumbnailPixels> > future;
+    };
+
+    /**
+     * A cache on disk of the thumbnails made by ui::ThumbnailSystem, shared
+     * by the file requester, the panels and the timeline, and kept between
+     * sessions.
+     *
+     * Thumbnails are stored as packed RGBA8 files, named by a hash of the
+     * path, modification time and size of the file, the time, the height
+     * and the I/O options, so a file changed on disk gets new thumbnails.
+     * The directory is the index: hits are touched and, when the cache
+     * grows over its maximum size, the least recently used files are
+     * removed.  Files are written under a temporary name and renamed, so
+     * several mrv2 instances can share the cache.
+     *
+     * Requests are served by a thread of the cache, which reads the disk,
+     * waits for the thumbnail system and flips the images for FLTK, so
+     * the user interface only has to wrap the pixels in a ThumbnailImage.
+     */
+    class ThumbnailCache
+    {
+    public:
+        ~ThumbnailCache();
+
+        //! Return the global thumbnail cache.
+        static ThumbnailCache& instance();
+
+        //! Set the maximum size of the cache in bytes.  0 disables it.
+        void setMaxSize(const uint64_t bytes);
+
+        //! Get the maximum size of the cache in bytes.
+        uint64_t getMaxSize() const;
+
+        /**
+         * Request a thumbnail.  The future returns null pixels when the
+         * thumbnail could not be made or the request was cancelled.
+         */
+        ThumbnailRequest getThumbnail(
+            const std::shared_ptr<ui::ThumbnailSystem>&, const file::Path&,
+            const int height,
+            const otime::RationalTime& = time::invalidTime,
+            const io::Options& = io::Options());
+
+        //! Cancel requests.
+        void cancelRequests(const std::vector<uint64_t>& ids);
+
+    private:
+        ThumbnailCache();
+
+        void _run();
+        void _write(const std::string& key, const ThumbnailPixels&);
+        void _trim(const uint64_t maxSize);
+
+        TLRENDER_PRIVATE();
+    };
+
+} // namespace mrv
@@ -8,6 +8,7 @@ namespace fs = std::filesystem;
 
 #include <tlIO/System.h>
 
+#include "mrvCore/mrvDirectoryScanner.h"
 #include "mrvCore/mrvFile.h"
 #include "mrvCore/mrvSequence.h"
 #include "mrvCore/mrvUtil.h"
@@ -56,42 +57,33 @@ namespace mrv
         const std::string& dir, std::vector<std::string>& movies,
         std::vector<std::string>& sequences, std::vector<std::string>& audios)
     {
+        const auto listing = DirectoryScanner::instance().list(dir);
 
-        // default constructor yields path iter. end
-        std::vector<std::string> files;
-        fs::directory_iterator e;
-        for (fs::directory_iterator i(dir); i != e; ++i)
+        std::vector<const DirectoryEntry*> files;
+        for (const auto& entry : listing->entries)
         {
-            if (!fs::exists(*i) || fs::is_directory(*i))
-                continue;
-
-            std::string file = (*i).path().string();
-            files.push_back(file);
+            if (!entry.isDir)
+                files.push_back(&entry);
         }
-        std::sort(files.begin(), files.end());
+        std::sort(
+            files.begin(), files.end(),
+            [](const DirectoryEntry* a, const DirectoryEntry* b)
+            { return a->name < b->name; });
 
-        std::string root, frame, view, ext;
         SequenceList tmpseqs;
 
-        for (const auto& file : files)
+        for (const auto& entry : files)
         {
-            file::Path path(file);
-            const std::string root = path.getBaseName();
-            const std::string frame = path.getNumber();
-            const std::string view = ""; // @todo: path.getView();
-            const std::string ext = path.getExtension();
+            const std::string& ext = entry->parts.ext;
+            const std::string file = (fs::path(dir) / entry->name).string();
             if (file::isMovie(ext))
                 movies.push_back(file);
             else if (file::isAudio(ext))
                 audios.push_back(file);
-            else if (file::isSequence(file))
+            else if (entry->isSequence)
             {
-                Sequence s;
-                s.root = root;
-                s.view = view;
-                s.number = frame;
-                s.ext = ext;
-
+                Sequence s = entry->parts;
+                s.root = (fs::path(dir) / s.root).string();
                 tmpseqs.push_back(s);
             }
         }
@@ -99,41 +91,11 @@ namespace mrv
         //
         // Then, sort sequences and collapse them into a single file entry
         //
-        std::sort(tmpseqs.begin(), tmpseqs.end(), SequenceSort());
-
-        std::string first;
-        std::string number;
-        int padding = -1;
-
-        for (const auto& i : tmpseqs)
+        for (const auto& i : collapseSequences(tmpseqs))
         {
-
-            const char* s = i.number.c_str();
-            int z = 0;
-            for (; *s == '0'; ++s)
-                ++z;
-
-            if (i.root != root || i.view != view || i.ext != ext ||
-                (padding != z && z != padding - 1))
-            {
-                // New sequence
-                root = i.root;
-                padding = z;
-                number = first = i.number;
-                view = i.view;
-                ext = i.ext;
-
-                std::string file = root;
-                file += first;
-                file += view;
-                file += ext;
-                sequences.push_back(file);
-            }
-            else
-            {
-                padding = z;
-                number = i.number;
-            }
+            const Sequence& first = i.first;
+            sequences.push_back(
+                first.root + first.number + first.view + first.ext);
         }
     }
 
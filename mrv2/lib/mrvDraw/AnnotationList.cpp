@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+
+#include "AnnotationList.h"
+
+namespace
+{
+    using mrv::draw::Annotation;
+
+    bool timeLess(
+        const std::shared_ptr< Annotation >& a, const otime::RationalTime& time)
+    {
+        return a->time < time;
+    }
+
+    bool lessTime(
+        const otime::RationalTime& time, const std::shared_ptr< Annotation >& a)
+    {
+        return time < a->time;
+    }
+} // namespace
+
+namespace mrv
+{
+    namespace draw
+    {
+        void AnnotationList::set(
+            const std::vector< std::shared_ptr< Annotation > >& value)
+        {
+            _annotations = value;
+
+            _byTime = value;
+            std::stable_sort(
+                _byTime.begin(), _byTime.end(),
+                [](const auto& a, const auto& b) { return a->time < b->time; });
+
+            _allFrames.clear();
+            _times.clear();
+            _times.reserve(_byTime.size());
+            for (const auto& annotation : _byTime)
+            {
+                _times.push_back(annotation->time);
+            }
+            for (const auto& annotation : _annotations)
+            {
+                if (annotation->allFrames)
+                    _allFrames.push_back(annotation);
+            }
+        }
+
+        void AnnotationList::add(const std::shared_ptr< Annotation >& value)
+        {
+            _annotations.push_back(value);
+
+            // Insert after the annotations with the same time, so find()
+            // returns the first one added.
+            const auto i = std::upper_bound(
+                _byTime.begin(), _byTime.end(), value->time, lessTime);
+            _times.insert(_times.begin() + (i - _byTime.begin()), value->time);
+            _byTime.insert(i, value);
+
+            if (value->allFrames)
+                _allFrames.push_back(value);
+        }
+
+        void AnnotationList::remove(const std::shared_ptr< Annotation >& value)
+        {
+            const auto i =
+                std::find(_annotations.begin(), _annotations.end(), value);
+            if (i == _annotations.end())
+                return;
+            _annotations.erase(i);
+
+            auto j = std::lower_bound(
+                _byTime.begin(), _byTime.end(), value->time, timeLess);
+            for (; j != _byTime.end() && (*j)->time == value->time; ++j)
+            {
+                if (*j != value)
+                    continue;
+                _times.erase(_times.begin() + (j - _byTime.begin()));
+                _byTime.erase(j);
+                break;
+            }
+
+            if (value->allFrames)
+            {
+                _allFrames.erase(
+                    std::remove(_allFrames.begin(), _allFrames.end(), value),
+                    _allFrames.end());
+            }
+        }
+
+        void AnnotationList::clear()
+        {
+            _annotations.clear();
+            _byTime.clear();
+            _allFrames.clear();
+            _times.clear();
+        }
+
+        std::shared_ptr< Annotation >
+        AnnotationList::find(const otime::RationalTime& time) const
+        {
+            const auto i = std::lower_bound(
+                _byTime.begin(), _byTime.end(), time, timeLess);
+            if (i == _byTime.end() || (*i)->time != time)
+                return nullptr;
+            return *i;
+        }
+
+        std::vector< std::shared_ptr< Annotation > > AnnotationList::find(
+            const otime::RationalTime& start,
+            const otime::RationalTime& end) const
+        {
+            std::vector< std::shared_ptr< Annotation > > out = _allFrames;
+
+            auto i = std::upper_bound(
+                _byTime.begin(), _byTime.end(), start, lessTime);
+            for (; i != _byTime.end() && (*i)->time < end; ++i)
+            {
+                if (!(*i)->allFrames)
+                    out.push_back(*i);
+            }
+            return out;
+        }
+
+    } // namespace draw
+
+} // namespace mrv
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mrvDraw/Annotation.h"
+
+namespace mrv
+{
+    namespace draw
+    {
+
+        /**
+         * Annotations of a timeline, indexed by time.  Annotations are kept
+         * in the order they were added (for saving them) and sorted by
+         * time, with the annotations shown on all frames in their own list,
+         * so looking up the annotations of a frame and its ghosting window
+         * is a binary search.
+         *
+         * Annotation times must not change while they are in the list.
+         */
+        class AnnotationList
+        {
+        public:
+            bool empty() const { return _annotations.empty(); }
+
+            //! All annotations, in the order they were added.
+            const std::vector< std::shared_ptr< Annotation > >& all() const
+            {
+                return _annotations;
+            }
+
+            //! Sorted times of all annotations.
+            const std::vector< otime::RationalTime >& times() const
+            {
+                return _times;
+            }
+
+            void set(const std::vector< std::shared_ptr< Annotation > >&);
+            void add(const std::shared_ptr< Annotation >&);
+            void remove(const std::shared_ptr< Annotation >&);
+            void clear();
+
+            //! First annotation added at a time or nullptr.
+            std::shared_ptr< Annotation >
+            find(const otime::RationalTime& time) const;
+
+            //! The annotations shown on all frames and the annotations with
+            //! times in (start, end), sorted by time.
+            std::vector< std::shared_ptr< Annotation > > find(
+                const otime::RationalTime& start,
+                const otime::RationalTime& end) const;
+
+        private:
+            std::vector< std::shared_ptr< Annotation > > _annotations;
+            std::vector< std::shared_ptr< Annotation > > _byTime;
+            std::vector< std::shared_ptr< Annotation > > _allFrames;
+            std::vector< otime::RationalTime > _times;
+        };
+
+    } // namespace draw
+
+} // namespace mrv
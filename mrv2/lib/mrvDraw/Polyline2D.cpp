@@ -73,51 +73,7 @@ namespace mrv
 
             if (segments.empty())
             {
-                const float w = thickness;
-                Point center = points[0];
-
-                if (!m_softEdges)
-                {
-                    // Splat, create a filled circle
-                    Point top = center + Point(0, -w);
-                    Point bottom = center + Point(0, w);
-
-                    createTriangleFan(
-                        center, center, top, bottom, 0.5, 0.0, false);
-                    createTriangleFan(
-                        center, center, top, bottom, 0.5, 0.0, true);
-                }
-                else
-                {
-                    // Splat, create a square with UVs
-                    Point start1 = Point(center.x - w, center.y - w);
-                    Point start2 = Point(center.x + w, center.y - w);
-                    Point end1 = Point(center.x + w, center.y + w);
-                    Point end2 = Point(center.x - w, center.y + w);
-
-                    V2f uvStart1 = V2f(0, 0);
-                    V2f uvStart2 = V2f(1, 0);
-                    V2f uvEnd1 = V2f(1, 1);
-                    V2f uvEnd2 = V2f(0, 1);
-
-                    size_t n = m_vertices.size();
-
-                    // emit vertices
-                    m_vertices.emplace_back(start1);
-                    m_vertices.emplace_back(start2);
-                    m_vertices.emplace_back(end1);
-                    m_vertices.emplace_back(end2);
-
-                    // emit UVs
-                    m_uvs.emplace_back(uvStart1);
-                    m_uvs.emplace_back(uvStart2);
-                    m_uvs.emplace_back(uvEnd1);
-                    m_uvs.emplace_back(uvEnd2);
-
-                    m_tris.emplace_back(IndexTriangle(n, n + 1, n + 2));
-                    m_tris.emplace_back(IndexTriangle(n + 2, n, n + 3));
-                }
-
+                createSplat(points[0], thickness);
                 return;
             }
 
@@ -150,24 +106,8 @@ namespace mrv
             }
             else if (endCapStyle == EndCapStyle::ROUND)
             {
-                if (m_softEdges)
-                {
-                    // If soft shader, we draw 3 triangles with UVs at each cap.
-                    createRoundSoftCap(firstSegment, false);
-                    createRoundSoftCap(lastSegment, true);
-                }
-                else
-                {
-                    // if solid shader, w draw half circle at caps
-                    createTriangleFan(
-                        firstSegment.center.a, firstSegment.center.a,
-                        firstSegment.edge1.a, firstSegment.edge2.a, 0.5, 0.0,
-                        false);
-                    createTriangleFan(
-                        lastSegment.center.b, lastSegment.center.b,
-                        lastSegment.edge1.b, lastSegment.edge2.b, 0.5, 0.0,
-                        true);
-                }
+                createRoundCap(firstSegment, false);
+                createRoundCap(lastSegment, true);
             }
             else if (endCapStyle == EndCapStyle::JOINT)
             {
@@ -203,6 +143,39 @@ namespace mrv
                         nextStart1, nextStart2, allowOverlap);
                 }
 
+                createSegment(start1, start2, end1, end2);
+
+                start1 = nextStart1;
+                start2 = nextStart2;
+            }
+        }
+
+        void Polyline2D::createSplat(const Point& center, const float thickness)
+        {
+            const float w = thickness;
+
+            if (!m_softEdges)
+            {
+                // Splat, create a filled circle
+                Point top = center + Point(0, -w);
+                Point bottom = center + Point(0, w);
+
+                createTriangleFan(center, center, top, bottom, 0.5, 0.0, false);
+                createTriangleFan(center, center, top, bottom, 0.5, 0.0, true);
+            }
+            else
+            {
+                // Splat, create a square with UVs
+                Point start1 = Point(center.x - w, center.y - w);
+                Point start2 = Point(center.x + w, center.y - w);
+                Point end1 = Point(center.x + w, center.y + w);
+                Point end2 = Point(center.x - w, center.y + w);
+
+                V2f uvStart1 = V2f(0, 0);
+                V2f uvStart2 = V2f(1, 0);
+                V2f uvEnd1 = V2f(1, 1);
+                V2f uvEnd2 = V2f(0, 1);
+
                 size_t n = m_vertices.size();
 
                 // emit vertices
@@ -212,21 +185,165 @@ namespace mrv
                 m_vertices.emplace_back(end2);
 
                 // emit UVs
-                if (m_softEdges)
+                m_uvs.emplace_back(uvStart1);
+                m_uvs.emplace_back(uvStart2);
+                m_uvs.emplace_back(uvEnd1);
+                m_uvs.emplace_back(uvEnd2);
+
+                m_tris.emplace_back(IndexTriangle(n, n + 1, n + 2));
+                m_tris.emplace_back(IndexTriangle(n + 2, n, n + 3));
+            }
+        }
+
+        void Polyline2D::createSegment(
+            const Point& start1, const Point& start2, const Point& end1,
+            const Point& end2)
+        {
+            size_t n = m_vertices.size();
+
+            // emit vertices
+            m_vertices.emplace_back(start1);
+            m_vertices.emplace_back(start2);
+            m_vertices.emplace_back(end1);
+            m_vertices.emplace_back(end2);
+
+            // emit UVs
+            if (m_softEdges)
+            {
+                m_uvs.emplace_back(V2f(0, 0.5));
+                m_uvs.emplace_back(V2f(1, 0.5));
+                m_uvs.emplace_back(V2f(0, 0.5));
+                m_uvs.emplace_back(V2f(1, 0.5));
+            }
+
+            // Create two triangles
+            m_tris.emplace_back(IndexTriangle(n, n + 1, n + 2));
+            m_tris.emplace_back(IndexTriangle(n + 2, n + 1, n + 3));
+        }
+
+        void Polyline2D::createRoundCap(
+            const PolySegment<Point>& segment, const bool end)
+        {
+            if (m_softEdges)
+            {
+                // If soft shader, we draw 3 triangles with UVs at each cap.
+                createRoundSoftCap(segment, end);
+            }
+            else if (!end)
+            {
+                // if solid shader, w draw half circle at caps
+                createTriangleFan(
+                    segment.center.a, segment.center.a, segment.edge1.a,
+                    segment.edge2.a, 0.5, 0.0, false);
+            }
+            else
+            {
+                createTriangleFan(
+                    segment.center.b, segment.center.b, segment.edge1.b,
+                    segment.edge2.b, 0.5, 0.0, true);
+            }
+        }
+
+        void Polyline2D::begin(
+            JointStyle jointStyle, EndCapStyle endCapStyle, bool allowOverlap)
+        {
+            assert(endCapStyle != EndCapStyle::JOINT);
+
+            m_jointStyle = jointStyle;
+            m_endCapStyle = endCapStyle;
+            m_allowOverlap = allowOverlap;
+
+            points.clear();
+            m_segments.clear();
+            m_vertices.clear();
+            m_uvs.clear();
+            m_tris.clear();
+            m_committedVertices = 0;
+            m_committedTriangles = 0;
+            m_changedTriangle = 0;
+        }
+
+        void Polyline2D::append(const Point& point)
+        {
+            m_changedTriangle = m_tris.size();
+
+            // Filter the point as in filterPoints()
+            if (!points.empty())
+            {
+                const Point tmp = points.back() - point;
+                const float length = tmp.length();
+                if (length <= m_width)
+                    return;
+            }
+            points.push_back(point);
+
+            // Remove the tail of the path (the last segment and the end
+            // cap, or the splat of a single point), as it changes.
+            m_vertices.resize(m_committedVertices);
+            if (m_softEdges)
+                m_uvs.resize(m_committedVertices);
+            m_tris.resize(m_committedTriangles);
+            m_changedTriangle = m_committedTriangles;
+
+            // operate on half the thickness to make our lives easier
+            const float thickness = m_width / 2;
+
+            if (points.size() == 1)
+            {
+                createSplat(point, thickness);
+                return;
+            }
+
+            const Point& previous = points[points.size() - 2];
+            PolySegment<Point> segment(
+                LineSegment<Point>(previous, point), thickness);
+
+            if (m_segments.empty())
+            {
+                // This is the first segment, so create the start of the
+                // path.
+                m_tailStart1 = segment.edge1.a;
+                m_tailStart2 = segment.edge2.a;
+                if (m_endCapStyle == EndCapStyle::SQUARE)
                 {
-                    m_uvs.emplace_back(V2f(0, 0.5));
-                    m_uvs.emplace_back(V2f(1, 0.5));
-                    m_uvs.emplace_back(V2f(0, 0.5));
-                    m_uvs.emplace_back(V2f(1, 0.5));
+                    m_tailStart1 =
+                        m_tailStart1 - segment.edge1.direction() * thickness;
+                    m_tailStart2 =
+                        m_tailStart2 - segment.edge2.direction() * thickness;
                 }
+                else if (m_endCapStyle == EndCapStyle::ROUND)
+                {
+                    createRoundCap(segment, false);
+                }
+            }
+            else
+            {
+                // The previous segment is no longer the last one, so join
+                // it to the new one and create it for good.
+                Point end1, end2, nextStart1, nextStart2;
+                createJoint(
+                    m_segments.back(), segment, m_jointStyle, end1, end2,
+                    nextStart1, nextStart2, m_allowOverlap);
+                createSegment(m_tailStart1, m_tailStart2, end1, end2);
+                m_tailStart1 = nextStart1;
+                m_tailStart2 = nextStart2;
+            }
+            m_segments.push_back(segment);
 
-                // Create two triangles
-                m_tris.emplace_back(IndexTriangle(n, n + 1, n + 2));
-                m_tris.emplace_back(IndexTriangle(n + 2, n + 1, n + 3));
+            m_committedVertices = m_vertices.size();
+            m_committedTriangles = m_tris.size();
 
-                start1 = nextStart1;
-                start2 = nextStart2;
+            // Create the tail
+            Point end1 = segment.edge1.b;
+            Point end2 = segment.edge2.b;
+            if (m_endCapStyle == EndCapStyle::SQUARE)
+            {
+                end1 = end1 + segment.edge1.direction() * thickness;
+                end2 = end2 + segment.edge2.direction() * thickness;
             }
+            createSegment(m_tailStart1, m_tailStart2, end1, end2);
+            if (m_endCapStyle == EndCapStyle::ROUND)
+                createRoundCap(segment, true);
         }
 
         void Polyline2D::createJoint(
@@ -126,6 +126,29 @@ namespace mrv
                 EndCapStyle endCapStyle = EndCapStyle::BUTT,
                 bool catmullRomSplines = false, bool allowOverlap = false);
 
+            /**
+             * Starts an empty path to be built one point at a time with
+             * append(), for strokes that grow while they are drawn.
+             * EndCapStyle::JOINT is not supported, as it connects the last
+             * point to the first one.
+             */
+            void begin(
+                JointStyle jointStyle = JointStyle::MITER,
+                EndCapStyle endCapStyle = EndCapStyle::BUTT,
+                bool allowOverlap = false);
+
+            /**
+             * Appends a point to a path started with begin().  Only the
+             * last segment, its joint with the previous one and the end
+             * cap are tessellated again, so the cost does not depend on
+             * the length of the path.
+             */
+            void append(const Point& point);
+
+            //! After append is called, return the first triangle that
+            //! changed.  Triangles before it are the same as before.
+            size_t getFirstChangedTriangle() const { return m_changedTriangle; }
+
         protected:
             /**
              * The threshold for mitered joints.
@@ -158,6 +181,29 @@ namespace mrv
 
             void filterPoints();
 
+            //! Create a filled circle or a soft square for a single point.
+            void createSplat(const Point& center, const float thickness);
+
+            //! Create the quad of a segment.
+            void createSegment(
+                const Point& start1, const Point& start2, const Point& end1,
+                const Point& end2);
+
+            //! Create the start or end cap of a path with round end caps.
+            void
+            createRoundCap(const PolySegment<Point>& segment, const bool end);
+
+            //! Incremental path state (see begin() and append()).
+            std::vector<PolySegment<Point>> m_segments;
+            JointStyle m_jointStyle = JointStyle::MITER;
+            EndCapStyle m_endCapStyle = EndCapStyle::BUTT;
+            bool m_allowOverlap = false;
+            Point m_tailStart1;
+            Point m_tailStart2;
+            size_t m_committedVertices = 0;
+            size_t m_committedTriangles = 0;
+            size_t m_changedTriangle = 0;
+
             void createJoint(
                 const PolySegment<Point>& segment1,
                 const PolySegment<Point>& segment2, JointStyle jointStyle,
@@ -2,6 +2,8 @@
 // mrv2
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
+#include <atomic>
+
 #include "mrvDraw/Shape.h"
 #include "mrvNetwork/mrvCypher.h"
 
@@ -9,6 +11,12 @@ namespace mrv
 {
     namespace draw
     {
+        uint64_t Shape::nextId()
+        {
+            static std::atomic<uint64_t> id(1);
+            return id++;
+        }
+
         void to_json(nlohmann::json& j, const Shape& value)
         {
             nlohmann::json matrix(value.matrix);
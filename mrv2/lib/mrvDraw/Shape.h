@@ -29,19 +29,50 @@ namespace mrv
         {
         public:
             Shape() :
+                id(nextId()),
                 color(0.F, 1.F, 0.F, 1.F),
                 soft(false),
                 laser(false),
                 fade(1.0F),
                 pen_size(5) {};
 
+            //! Copies get an id of their own, so they do not share the
+            //! meshes of the original.
+            Shape(const Shape& b) :
+                id(nextId()),
+                matrix(b.matrix),
+                color(b.color),
+                soft(b.soft),
+                laser(b.laser),
+                fade(b.fade),
+                pen_size(b.pen_size) {};
+
+            //! Assignment keeps the id of the shape.
+            Shape& operator=(const Shape& b)
+            {
+                matrix = b.matrix;
+                color = b.color;
+                soft = b.soft;
+                laser = b.laser;
+                fade = b.fade;
+                pen_size = b.pen_size;
+                return *this;
+            }
+
             virtual ~Shape() {};
 
             virtual void draw(
                 const std::shared_ptr<tl::timeline::IRender>&,
                 const std::shared_ptr<opengl::Lines>&) = 0;
 
+            //! Return a new shape id.
+            static uint64_t nextId();
+
         public:
+            //! Id of the shape, unique for the session, that keys its
+            //! meshes on the GPU.  Unlike its address, it is not reused
+            //! by a later shape.
+            uint64_t id;
             math::Matrix4x4f matrix;
             image::Color4f color;
             bool soft;
@@ -633,10 +633,15 @@ namespace mrv
         }
 
         //! Offset annotations by offset time.  Used in cut/insert frame.
+        //! The annotations are deep copied, as the ones of the player
+        //! must not change their time while in its annotation list.
         std::vector<std::shared_ptr<draw::Annotation>> offsetAnnotations(
             const RationalTime& time, const RationalTime& offset,
-            const std::vector<std::shared_ptr<draw::Annotation>>& annotations)
+            const std::vector<std::shared_ptr<draw::Annotation>>&
+                originalAnnotations)
         {
+            auto annotations = deepCopyAnnotations(originalAnnotations);
+
             std::vector<std::shared_ptr<draw::Annotation>> out;
             // Append annotations that come before.
             for (auto a : annotations)
@@ -2252,8 +2257,9 @@ namespace mrv
         if (startTimeOpt.has_value())
         {
             startTime = startTimeOpt.value();
-            offsetAnnotations(
+            auto annotations = offsetAnnotations(
                 startTime, -startTime, player->getAllAnnotations());
+            player->setAllAnnotations(annotations);
         }
 
         const auto& stack = timeline->tracks();
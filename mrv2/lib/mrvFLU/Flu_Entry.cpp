@@ -21,6 +21,7 @@
 
 #include "mrvCore/mrvFile.h"
 #include "mrvCore/mrvI8N.h"
+#include "mrvCore/mrvThumbnailCache.h"
 
 #include "mrvUI/mrvAsk.h"
 #include "mrvUI/mrvUtil.h"
@@ -94,7 +95,7 @@ struct Flu_Entry::Private
     struct ThumbnailData
     {
         bool init = true;
-        ui::ThumbnailRequest request;
+        mrv::ThumbnailRequest request;
     };
     ThumbnailData thumbnail;
 
@@ -162,35 +163,13 @@ void Flu_Entry::timerEvent()
         p.thumbnail.request.future.wait_for(std::chrono::seconds(0)) ==
             std::future_status::ready)
     {
-        if (auto image = p.thumbnail.request.future.get())
+        if (auto pixels = p.thumbnail.request.future.get())
         {
-            if (image::PixelType::RGBA_U8 == image->getPixelType())
-            {
-                const int w = image->getWidth();
-                const int h = image->getHeight();
-                const int depth = 4;
-
-                uint8_t* pixelData = new uint8_t[w * h * depth];
-
-                auto rgbImage = new Fl_RGB_Image(pixelData, w, h, depth);
-                rgbImage->alloc_array = true;
-
-                uint8_t* d = pixelData;
-                const uint8_t* s = image->getData();
-                for (int y = 0; y < h; ++y)
-                {
-                    memcpy(d + (h - 1 - y) * w * 4, s + y * w * 4, w * 4);
-                }
-                bind_image(rgbImage);
-                updateSize();
-                redraw();
-                Fl_Group* g = chooser->getEntryGroup();
-                g->redraw();
-            }
-            else
-            {
-                isPicture = false;
-            }
+            bind_image(new mrv::ThumbnailImage(pixels));
+            updateSize();
+            redraw();
+            Fl_Group* g = chooser->getEntryGroup();
+            g->redraw();
         }
         else
         {
@@ -950,7 +929,8 @@ void Flu_Entry::startRequest()
             }
         }
 
-        p.thumbnail.request = thumbnailSystem->getThumbnail(path, size.h, time);
+        p.thumbnail.request = mrv::ThumbnailCache::instance().getThumbnail(
+            thumbnailSystem, path, size.h, time);
         p.thumbnail.init = false;
         isPicture = true;
         Fl::add_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
@@ -972,7 +952,8 @@ void Flu_Entry::cancelRequest()
 
     if (auto thumbnailSystem = p.thumbnailSystem.lock())
     {
-        thumbnailSystem->cancelRequests({p.thumbnail.request.id});
+        mrv::ThumbnailCache::instance().cancelRequests(
+            {p.thumbnail.request.id});
 
         p.thumbnail.init = true;
         Fl::remove_timeout((Fl_Timeout_Handler)timerEvent_cb, this);
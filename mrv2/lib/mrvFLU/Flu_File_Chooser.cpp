@@ -22,6 +22,8 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 
+#include <chrono>
+#include <future>
 #include <random>
 #include <iostream>
 #include <algorithm>
@@ -61,6 +63,7 @@
 
 #include <tlUI/ThumbnailSystem.h>
 
+#include "mrvCore/mrvDirectoryScanner.h"
 #include "mrvCore/mrvFile.h"
 #include "mrvCore/mrvHome.h"
 #include "mrvCore/mrvLocale.h"
@@ -85,6 +88,9 @@
 namespace
 {
     const char* kModule = "flu";
+
+    //! Time waited for a directory listing between checks for events.
+    const std::chrono::milliseconds kScanWait(20);
 }
 
 // set default language strings
@@ -221,6 +227,10 @@ static std::string flu_get_special_folder(int csidl)
 struct Flu_File_Chooser::Private
 {
     std::shared_ptr<system::Context> context;
+
+    //! Incremented on each cd(), so a cd() waiting for its directory
+    //! listing knows when the user went elsewhere.
+    unsigned cdSerial = 0;
 };
 
 void Flu_File_Chooser::previewCB()
@@ -3723,31 +3733,25 @@ void Flu_File_Chooser::cd(const char* path)
 
     mrv::SequenceList tmpseqs;
 
-    // read the directory as UTF-8
-    dirent** e;
-    char* name;
-    int num = fl_filename_list(pathbase.c_str(), &e);
-    if (num > 0)
+    // List the directory on the scanner, keeping the user interface alive
+    // while waiting for it.
+    const unsigned serial = ++p.cdSerial;
+    auto scan = mrv::DirectoryScanner::instance().scan(pathbase);
+    while (scan.wait_for(kScanWait) != std::future_status::ready)
     {
-        int i;
+        Fl::check();
+        if (serial != p.cdSerial)
+            return;
+    }
+    const auto listing = scan.get();
 
-        for (i = 0; i < num; i++)
+    int num = listing->entries.size();
+    if (num > 0)
+    {
+        for (const auto& dirEntry : listing->entries)
         {
-            name = e[i]->d_name;
-
-            // ignore the "." and ".." names
-            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0 ||
-                strcmp(name, "./") == 0 || strcmp(name, "../") == 0 ||
-                strcmp(name, ".\\") == 0 || strcmp(name, "..\\") == 0)
-                continue;
-
-            // if 'name' ends in '/', remove it
-            if (name[strlen(name) - 1] == '/')
-                name[strlen(name) - 1] = '\0';
-
-            // file or directory?
-            fullpath = pathbase + name;
-            isDir = (fl_filename_isdir(fullpath.c_str()) != 0);
+            const char* name = dirEntry.name.c_str();
+            isDir = dirEntry.isDir;
 
             // was this file specified explicitly?
             isCurrentFile = (currentFile == name);
@@ -3818,14 +3822,13 @@ void Flu_File_Chooser::cd(const char* path)
             }
             else
             {
+                // The name was parsed by the scanner.
+                const mrv::Sequence& parts = dirEntry.parts;
+                const std::string& root = parts.root;
+                const std::string& frame = parts.number;
+                const std::string& ext = parts.ext;
 
-                file::Path path(name);
-                const std::string root = path.getBaseName();
-                const std::string frame = path.getNumber();
-                const std::string view = ""; // @todo: path.getView();
-                const std::string ext = path.getExtension();
-
-                bool is_sequence = mrv::file::isSequence(name);
+                bool is_sequence = dirEntry.isSequence;
                 if (compact_files())
                 {
                     if (mrv::file::isMovie(ext) || mrv::file::isAudio(ext) ||
@@ -3840,12 +3843,7 @@ void Flu_File_Chooser::cd(const char* path)
 
                 if (is_sequence)
                 {
-                    mrv::Sequence seq;
-                    seq.ext = ext;
-                    seq.view = view;
-                    seq.number = frame;
-                    seq.root = root;
-                    tmpseqs.push_back(seq);
+                    tmpseqs.push_back(parts);
                 }
                 else
                 {
@@ -3890,121 +3888,39 @@ void Flu_File_Chooser::cd(const char* path)
         // Then, sort sequences and collapse them into a single file entry
         //
         {
-            std::sort(tmpseqs.begin(), tmpseqs.end(), mrv::SequenceSort());
-
-            std::string root;
-            std::string first;
-            std::string number;
-            std::string view;
-            std::string ext;
-            int zeros = -1;
-
-            std::string seqname;
-            mrv::SequenceList seqs;
-
-            {
-                mrv::SequenceList::iterator i = tmpseqs.begin();
-                mrv::SequenceList::iterator e = tmpseqs.end();
-                for (; i != e; ++i)
-                {
-                    const char* s = (*i).number.c_str();
-                    int z = 0;
-                    for (; *s == '0'; ++s)
-                        ++z;
-
-                    if ((*i).root != root || (*i).view != view ||
-                        (*i).ext != ext || (zeros != z && z != zeros - 1))
-                    {
-                        // New sequence
-                        if (seqname != "")
-                        {
-                            mrv::Sequence seq;
-                            seq.root = seqname;
-                            seq.number = seq.ext = first;
-                            if (first != number)
-                            {
-                                seq.ext = number;
-                            }
-                            seq.view = (*i).view;
-                            seqs.push_back(seq);
-                        }
-
-                        root = (*i).root;
-                        zeros = z;
-                        number = first = (*i).number;
-                        view = (*i).view;
-                        ext = (*i).ext;
-
-                        seqname = root;
-                        seqname += view;
-                        if (z == 0)
-                            seqname += "%d";
-                        else
-                        {
-                            seqname += "%0";
-                            char buf[19];
-                            buf[18] = 0;
-#ifdef _WIN32
-                            seqname += itoa(int((*i).number.size()), buf, 10);
-#else
-                            snprintf(buf, 18, "%ld", (*i).number.size());
-                            seqname += buf;
-#endif
-                            seqname += "d";
-                        }
-                        seqname += ext;
-                    }
-                    else
-                    {
-                        zeros = z;
-                        number = (*i).number;
-                    }
-                }
-            }
-
-            if (!root.empty() || !first.empty())
-            {
-                mrv::Sequence seq;
-                seq.root = seqname;
-                seq.number = seq.ext = first;
-                seq.view = view;
-                if (first != number)
-                {
-                    seq.ext = number;
-                }
-                seqs.push_back(seq);
-            }
-
-            mrv::SequenceList::const_iterator i = seqs.begin();
-            mrv::SequenceList::const_iterator e = seqs.end();
-            for (const auto& i : seqs)
+            for (const auto& i : mrv::collapseSequences(tmpseqs))
             {
-                int numFrames =
-                    1 + (atoi(i.ext.c_str()) - atoi(i.number.c_str()));
+                const mrv::Sequence& first = i.first;
+                const int numFrames = 1 + (i.last.frame - first.frame);
                 if (numFrames == 1)
                 {
-                    int number = atoi(i.number.c_str());
-                    char buf[1024];
-                    snprintf(buf, 1024, i.root.c_str(), number);
                     entry = new Flu_Entry(
-                        buf, ENTRY_FILE, fileDetailsBtn->value(), this,
-                        p.context);
+                        (first.root + first.number + first.view + first.ext)
+                            .c_str(),
+                        ENTRY_FILE, fileDetailsBtn->value(), this, p.context);
                 }
                 else
                 {
+                    std::string seqname = first.root + first.view;
+                    if (first.number[0] != '0')
+                        seqname += "%d";
+                    else
+                    {
+                        seqname += "%0";
+                        seqname += std::to_string(first.number.size());
+                        seqname += "d";
+                    }
+                    seqname += first.ext;
 
                     entry = new Flu_Entry(
-                        i.root.c_str(), ENTRY_SEQUENCE, fileDetailsBtn->value(),
-                        this, p.context);
+                        seqname.c_str(), ENTRY_SEQUENCE,
+                        fileDetailsBtn->value(), this, p.context);
                     entry->isize = numFrames;
-                    entry->altname = i.root.c_str();
+                    entry->altname = seqname.c_str();
 
-                    entry->filesize = i.number;
-                    if (entry->isize > 1)
-                    {
-                        entry->filesize += "-";
-                        entry->filesize += i.ext;
-                    }
+                    entry->filesize = first.number;
+                    entry->filesize += "-";
+                    entry->filesize += i.last.number;
                 }
 
                 entry->updateSize();
@@ -4064,8 +3980,6 @@ void Flu_File_Chooser::cd(const char* path)
 
     } // num > 0
 
-    fl_filename_free_list(&e, num);
-
     // sort the files: directories first, then files
 
     if (listMode)
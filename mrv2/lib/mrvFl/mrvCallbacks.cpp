@@ -14,6 +14,7 @@
 
 #include "mrvCore/mrvFileManager.h"
 #include "mrvCore/mrvHome.h"
+#include "mrvCore/mrvThumbnailCache.h"
 #include "mrvCore/mrvUtil.h"
 
 #include "mrvWidgets/mrvMultilineInput.h"
@@ -107,6 +108,7 @@ namespace mrv
         {_("USD"), (Fl_Callback*)usd_panel_cb},
 #endif
         {_("Vectorscope"), (Fl_Callback*)vectorscope_panel_cb},
+        {_("Waveform"), (Fl_Callback*)waveform_panel_cb},
         {_("Hotkeys"), (Fl_Callback*)nullptr},
         {_("Preferences"), (Fl_Callback*)nullptr},
         {_("About"), (Fl_Callback*)nullptr},
@@ -598,6 +600,8 @@ namespace mrv
             panel::histogramPanel->save();
         if (panel::vectorscopePanel)
             panel::vectorscopePanel->save();
+        if (panel::waveformPanel)
+            panel::waveformPanel->save();
         if (panel::environmentMapPanel)
             panel::environmentMapPanel->save();
 #ifdef MRV2_PYBIND11
@@ -922,6 +926,8 @@ namespace mrv
         {
             App* app = ui->app;
             view->setContext(app->getContext());
+            view->setReadbackBuffers(app->settings()->getValue<int>(
+                "Performance/ReadbackBuffers"));
             view->setOCIOOptions(ui->uiView->getOCIOOptions());
             view->setLUTOptions(app->lutOptions());
             timeline::ImageOptions imageOptions = app->imageOptions();
@@ -2420,6 +2426,10 @@ namespace mrv
         ioSystem->getCache()->clear();
 
         player->clearCache();
+
+        // Thumbnails are made again, so the buffers kept for them are not
+        // needed.
+        ThumbnailPixels::releasePool();
     }
     
     void refresh_movie_cb(Fl_Menu_* m, void* d)
@@ -11,6 +11,7 @@
 #include <atomic>
 
 #include "mrvFl/mrvIO.h"
+#include "mrvFl/mrvScheduler.h"
 
 namespace mrv
 {
@@ -33,12 +34,12 @@ namespace mrv
     {
         _p->context = context;
 
-        Fl::add_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
+        scheduler::add((Fl_Timeout_Handler)timerEvent_cb, this, kTimeout);
     }
 
     ContextObject::~ContextObject()
     {
-        Fl::remove_timeout((Fl_Timeout_Handler)timerEvent_cb, this);
+        scheduler::remove((Fl_Timeout_Handler)timerEvent_cb, this);
     }
 
     const std::shared_ptr<system::Context>& ContextObject::context() const
@@ -53,7 +54,7 @@ namespace mrv
             _p->context->tick();
         }
 
-        Fl::repeat_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
+        scheduler::repeat((Fl_Timeout_Handler)timerEvent_cb, this);
     }
 
     void ContextObject::timerEvent_cb(void* d)
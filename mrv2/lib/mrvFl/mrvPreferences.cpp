@@ -7,6 +7,7 @@
 namespace fs = std::filesystem;
 
 #include <tlCore/AudioSystem.h>
+#include <tlCore/Memory.h>
 #include <tlCore/StringFormat.h>
 
 #include <FL/fl_utf8.h>         // for fl_getenv
@@ -17,6 +18,7 @@ namespace fs = std::filesystem;
 #include "mrvCore/mrvHotkey.h"
 #include "mrvCore/mrvLocale.h"
 #include "mrvCore/mrvMedia.h"
+#include "mrvCore/mrvThumbnailCache.h"
 #include "mrvCore/mrvUtil.h"
 
 #include "mrvWidgets/mrvLogDisplay.h"
@@ -304,6 +306,9 @@ namespace mrv
         gui.get("panel_thumbnails", tmp, 1);
         uiPrefs->uiPrefsPanelThumbnails->value(tmp);
 
+        gui.get("thumbnail_disk_cache", tmp, 512);
+        uiPrefs->uiPrefsThumbnailDiskCache->value(tmp);
+
         gui.get("remove_edls", tmp, 1);
         uiPrefs->uiPrefsRemoveEDLs->value(tmp);
 
@@ -644,6 +649,8 @@ namespace mrv
         uiPrefs->uiPrefsHudMemory->value((bool)tmp);
         hud.get("attributes", tmp, 0);
         uiPrefs->uiPrefsHudAttributes->value((bool)tmp);
+        hud.get("readback", tmp, 0);
+        uiPrefs->uiPrefsHudReadback->value((bool)tmp);
 
         Fl_Preferences win(view, "window");
 
@@ -1223,6 +1230,9 @@ namespace mrv
         gui.set(
             "timeline_thumbnails", uiPrefs->uiPrefsTimelineThumbnails->value());
         gui.set("panel_thumbnails", uiPrefs->uiPrefsPanelThumbnails->value());
+        gui.set(
+            "thumbnail_disk_cache",
+            (int)uiPrefs->uiPrefsThumbnailDiskCache->value());
         gui.set("remove_edls", uiPrefs->uiPrefsRemoveEDLs->value());
         gui.set("timeline_edit_mode", uiPrefs->uiPrefsEditMode->value());
         gui.set("timeline_edit_view", uiPrefs->uiPrefsEditView->value());
@@ -1317,6 +1327,7 @@ namespace mrv
         hud.set("cache", uiPrefs->uiPrefsHudCache->value());
         hud.set("memory", uiPrefs->uiPrefsHudMemory->value());
         hud.set("attributes", uiPrefs->uiPrefsHudAttributes->value());
+        hud.set("readback", uiPrefs->uiPrefsHudReadback->value());
 
         {
             Fl_Preferences win(view, "window");
@@ -1694,6 +1705,13 @@ namespace mrv
 
             ui->uiView->setMissingFrameType(static_cast<MissingFrameType>(
                 uiPrefs->uiMissingFrameType->value()));
+
+            const int readbackBuffers =
+                settings->getValue<int>("Performance/ReadbackBuffers");
+            ui->uiView->setReadbackBuffers(readbackBuffers);
+            if (ui->uiSecondary)
+                ui->uiSecondary->viewport()->setReadbackBuffers(
+                    readbackBuffers);
         }
 
         TimelineClass* t = ui->uiTimeWindow;
@@ -1716,6 +1734,11 @@ namespace mrv
         Flu_File_Chooser::thumbnailsFileReq =
             (bool)uiPrefs->uiPrefsFileReqThumbnails->value();
 
+        const double diskCache =
+            std::max(0.0, uiPrefs->uiPrefsThumbnailDiskCache->value());
+        ThumbnailCache::instance().setMaxSize(
+            static_cast<uint64_t>(diskCache) * memory::megabyte);
+
         Flu_File_Chooser::singleButtonTravelDrawer =
             (bool)uiPrefs->uiPrefsFileReqFolder->value();
 
@@ -1808,6 +1831,9 @@ namespace mrv
         if (uiPrefs->uiPrefsHudMemory->value())
             hud |= HudDisplay::kMemory;
 
+        if (uiPrefs->uiPrefsHudReadback->value())
+            hud |= HudDisplay::kReadback;
+
         view->setHudDisplay((HudDisplay)hud);
 
         //
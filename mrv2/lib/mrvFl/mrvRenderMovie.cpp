@@ -0,0 +1,363 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <string>
+
+#include <tlIO/System.h>
+
+#include <tlCore/StringFormat.h>
+#include <tlCore/Time.h>
+
+#include <tlGL/GLFWWindow.h>
+#include <tlGL/OffscreenBuffer.h>
+#include <tlGL/Util.h>
+
+#include <tlTimelineGL/Render.h>
+
+#include <tlTimeline/Timeline.h>
+
+#include "mrvCore/mrvFile.h"
+#include "mrvCore/mrvLocale.h"
+
+#include "mrvGL/mrvGLFrameReadback.h"
+
+#include "mrvFl/mrvSave.h"
+#include "mrvFl/mrvSaveCheckpoint.h"
+#include "mrvFl/mrvSaveQueue.h"
+#include "mrvFl/mrvIO.h"
+
+namespace
+{
+    const char* kModule = "render";
+
+    //! Frames being read back from the GPU while the next ones render.
+    const unsigned kReadbackCount = 3;
+
+    //! Output images waiting to be written.
+    const unsigned kImageCount = 3;
+
+    //! Frames requested ahead of the frame being rendered.
+    const size_t kVideoRequestCount = 16;
+} // namespace
+
+namespace mrv
+{
+
+    int render_movie(
+        const std::string& input, const std::string& output,
+        const std::shared_ptr<system::Context>& context,
+        const RenderOptions& options)
+    {
+        int out = 1;
+        std::string msg;
+
+        try
+        {
+            if (input == output)
+            {
+                throw std::runtime_error(
+                    string::Format(_("{0}: Cannot render over the input."))
+                        .arg(output));
+            }
+
+            // Create the hidden window first, as the timeline and the
+            // renderer need an OpenGL context.
+            auto window = gl::GLFWWindow::create(
+                "bake", math::Size2i(1, 1), context,
+                static_cast<int>(gl::GLFWWindowOptions::MakeCurrent));
+
+            auto timeline =
+                options.audioFileName.empty()
+                    ? timeline::Timeline::create(file::Path(input), context)
+                    : timeline::Timeline::create(
+                          file::Path(input),
+                          file::Path(options.audioFileName), context);
+
+            const auto& info = timeline->getIOInfo();
+            if (info.video.empty())
+            {
+                throw std::runtime_error(
+                    string::Format(_("{0}: No video to render.")).arg(input));
+            }
+
+            auto timeRange = timeline->getTimeRange();
+            if (time::isValid(options.inOutRange))
+                timeRange = options.inOutRange;
+            const auto startTime = timeRange.start_time();
+            const auto endTime = timeRange.end_time_inclusive();
+
+            const double videoRate = info.videoTime.duration().rate();
+            const otime::TimeRange videoTime(
+                startTime.rescaled_to(videoRate),
+                timeRange.duration().rescaled_to(videoRate));
+
+            const SaveOptions& saveOptions = options.saveOptions;
+            image::Size renderSize = info.video[0].size;
+            if (saveOptions.resolution == SaveResolution::kHalfSize)
+            {
+                renderSize.w /= 2;
+                renderSize.h /= 2;
+            }
+            else if (saveOptions.resolution == SaveResolution::kQuarterSize)
+            {
+                renderSize.w /= 4;
+                renderSize.h /= 4;
+            }
+
+            // Create the writer.
+            file::Path path(output);
+            const std::string& extension = path.getExtension();
+            auto ioSystem = context->getSystem<io::System>();
+            auto writerPlugin = ioSystem->getPlugin(path);
+            if (!writerPlugin)
+            {
+                throw std::runtime_error(
+                    string::Format(_("{0}: Cannot open writer plugin."))
+                        .arg(output));
+            }
+
+            gl::OffscreenBufferOptions offscreenBufferOptions;
+            offscreenBufferOptions.colorType = image::PixelType::RGBA_F32;
+
+            image::Info outputInfo;
+            outputInfo.size = renderSize;
+            outputInfo.pixelType = info.video[0].pixelType;
+            outputInfo = writerPlugin->getWriteInfo(outputInfo);
+            if (image::PixelType::None == outputInfo.pixelType)
+            {
+                outputInfo.pixelType = image::PixelType::RGB_U8;
+                offscreenBufferOptions.colorType = image::PixelType::RGB_U8;
+            }
+#ifdef TLRENDER_EXR
+            if (string::compare(
+                    extension, ".exr", string::Compare::CaseInsensitive))
+            {
+                outputInfo.pixelType = saveOptions.exrPixelType;
+                offscreenBufferOptions.colorType = image::PixelType::RGBA_F32;
+            }
+#endif
+            if (string::compare(
+                    extension, ".hdr", string::Compare::CaseInsensitive))
+            {
+                outputInfo.pixelType = image::PixelType::RGB_F32;
+                offscreenBufferOptions.colorType = image::PixelType::RGB_F32;
+            }
+
+            if (GL_NONE == gl::getReadPixelsFormat(outputInfo.pixelType) ||
+                GL_NONE == gl::getReadPixelsType(outputInfo.pixelType))
+            {
+                throw std::runtime_error(
+                    string::Format(_("{0}: Invalid OpenGL format and type"))
+                        .arg(output));
+            }
+
+            io::Info ioInfo;
+            ioInfo.videoTime = videoTime;
+            ioInfo.video.push_back(outputInfo);
+
+            // Audio is only saved to movies.
+            const double sampleRate = info.audio.sampleRate;
+            bool hasAudio = info.audio.isValid() && file::isMovie(path);
+#ifdef TLRENDER_FFMPEG
+            if (saveOptions.ffmpegAudioCodec == ffmpeg::AudioCodec::None)
+                hasAudio = false;
+#endif
+            if (hasAudio)
+            {
+                ioInfo.audio = info.audio;
+                ioInfo.audioTime = otime::TimeRange(
+                    startTime.rescaled_to(sampleRate),
+                    timeRange.duration().rescaled_to(sampleRate));
+            }
+
+            io::Options ioOptions = getSaveIOOptions(saveOptions);
+            const auto writers = SaveQueue::createWriters(
+                writerPlugin, path, ioInfo, ioOptions);
+            if (writers.empty())
+            {
+                throw std::runtime_error(
+                    string::Format("{0}: Cannot open").arg(output));
+            }
+
+            msg = string::Format(_("Rendering {0} to {1} ({2} {3})."))
+                      .arg(input)
+                      .arg(output)
+                      .arg(outputInfo.size)
+                      .arg(outputInfo.pixelType);
+            LOG_INFO(msg);
+
+            auto render = timeline_gl::Render::create(context);
+            const math::Size2i offscreenBufferSize(
+                renderSize.w, renderSize.h);
+            auto buffer = gl::OffscreenBuffer::create(
+                offscreenBufferSize, offscreenBufferOptions);
+
+            timeline::OCIOOptions ocioOptions = options.ocioOptions;
+            ocioOptions.enabled =
+                !ocioOptions.input.empty() ||
+                (!ocioOptions.display.empty() && !ocioOptions.view.empty());
+            timeline::LUTOptions lutOptions = options.lutOptions;
+            lutOptions.enabled = !lutOptions.fileName.empty();
+
+            opengl::FrameReadback readback(outputInfo, kReadbackCount);
+            // Image sequences keep a checkpoint of the frames written, so
+            // an interrupted render is resumed by running it again.
+            std::unique_ptr<SaveCheckpoint> checkpoint;
+            if (!file::isMovie(path))
+            {
+                checkpoint = std::make_unique<SaveCheckpoint>(
+                    path, input, saveOptions, outputInfo, ioOptions,
+                    timeRange);
+                if (checkpoint->resumedFrames() > 0)
+                {
+                    msg = string::Format(_("Resuming render.  {0} frames "
+                                           "were already saved."))
+                              .arg(checkpoint->resumedFrames());
+                    LOG_INFO(msg);
+                }
+            }
+
+            SaveQueue queue(writers, outputInfo, kImageCount);
+            if (checkpoint)
+            {
+                queue.setWriteCallback(
+                    [&checkpoint](const otime::RationalTime& time)
+                    { checkpoint->add(time); });
+            }
+
+            auto writeFrame = [&]
+            {
+                auto image = queue.getImage();
+                const auto time = readback.retrieve(image);
+                queue.writeVideo(time, image);
+            };
+
+            // Audio is written in the chunks of one second returned by the
+            // timeline, clamped to the time range.
+            const int64_t firstSample =
+                hasAudio ? startTime.rescaled_to(sampleRate).value() : 0;
+            const int64_t totalSamples =
+                hasAudio ? ioInfo.audioTime.duration().value() : 0;
+            int64_t writtenSamples = 0;
+            auto writeAudio = [&](const int64_t sampleCount)
+            {
+                while (writtenSamples < sampleCount)
+                {
+                    const int64_t sample = firstSample + writtenSamples;
+                    const int64_t seconds =
+                        static_cast<int64_t>(std::floor(sample / sampleRate));
+                    const auto audioData =
+                        timeline->getAudio(seconds).future.get();
+                    if (audioData.layers.empty() ||
+                        !audioData.layers[0].audio)
+                        break;
+
+                    // \todo mix audio layers.
+                    const auto& audio = audioData.layers[0].audio;
+                    const int64_t offset =
+                        sample - static_cast<int64_t>(seconds * sampleRate);
+                    const int64_t count = std::min(
+                        static_cast<int64_t>(audio->getSampleCount()) - offset,
+                        sampleCount - writtenSamples);
+                    if (count <= 0)
+                        break;
+
+                    const size_t byteCount = audio->getInfo().getByteCount();
+                    auto chunk = audio::Audio::create(audio->getInfo(), count);
+                    memcpy(
+                        chunk->getData(),
+                        audio->getData() + offset * byteCount,
+                        count * byteCount);
+                    queue.writeAudio(
+                        otime::TimeRange(
+                            otime::RationalTime(sample, sampleRate),
+                            otime::RationalTime(count, sampleRate)),
+                        chunk);
+                    writtenSamples += count;
+                }
+            };
+
+            std::deque<timeline::VideoRequest> videoRequests;
+            auto requestTime = startTime;
+            const otime::RationalTime frame(1, startTime.rate());
+            for (auto currentTime = startTime; currentTime <= endTime;
+                 currentTime += frame)
+            {
+                while (videoRequests.size() < kVideoRequestCount &&
+                       requestTime <= endTime)
+                {
+                    if (!checkpoint || !checkpoint->isDone(requestTime))
+                        videoRequests.push_back(
+                            timeline->getVideo(requestTime));
+                    requestTime += frame;
+                }
+
+                if (checkpoint && checkpoint->isDone(currentTime))
+                    continue;
+
+                const auto videoData = videoRequests.front().future.get();
+                videoRequests.pop_front();
+                if (videoData.layers.empty() || !videoData.layers[0].image)
+                {
+                    msg = string::Format(_("Empty video data at time {0}."))
+                              .arg(currentTime);
+                    LOG_ERROR(msg);
+                }
+
+                {
+                    gl::OffscreenBufferBinding binding(buffer);
+                    {
+                        locale::SetAndRestore saved;
+                        render->begin(offscreenBufferSize);
+                        render->setOCIOOptions(ocioOptions);
+                        render->setLUTOptions(lutOptions);
+                        render->drawVideo(
+                            {videoData},
+                            {math::Box2i(0, 0, renderSize.w, renderSize.h)},
+                            {timeline::ImageOptions()},
+                            {timeline::DisplayOptions()},
+                            timeline::CompareOptions(),
+                            timeline::BackgroundOptions());
+                        render->end();
+                    }
+
+                    if (readback.isFull())
+                        writeFrame();
+                    readback.read(0, 0, currentTime);
+                }
+
+                if (hasAudio)
+                {
+                    const auto elapsed = currentTime + frame - startTime;
+                    writeAudio(std::min(
+                        static_cast<int64_t>(
+                            elapsed.rescaled_to(sampleRate).value()),
+                        totalSamples));
+                }
+
+                msg = string::Format(_("Rendering... {0}")).arg(currentTime);
+                LOG_INFO(msg);
+            }
+
+            while (readback.size() > 0)
+                writeFrame();
+            queue.finish();
+            if (checkpoint)
+                checkpoint->finish();
+
+            out = 0;
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR(e.what());
+        }
+
+        return out;
+    }
+
+} // namespace mrv
@@ -2,8 +2,12 @@
 // mrv2
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
+#pragma once
+
 #include <tlIO/IO.h>
 
+#include <tlCore/Context.h>
+
 #include "mrvSaveOptions.h"
 
 class ViewerUI;
@@ -20,4 +24,16 @@ namespace mrv
         const std::string& file, const ViewerUI* ui,
         SaveOptions options = SaveOptions());
 
+    //! I/O options of the writers for the save options.
+    tl::io::Options getSaveIOOptions(const SaveOptions& options);
+
+    /**
+     * Render a timeline to a movie or image sequence without the user
+     * interface, in a hidden window.  Returns 0 if successful, 1 if not.
+     */
+    int render_movie(
+        const std::string& input, const std::string& output,
+        const std::shared_ptr<tl::system::Context>& context,
+        const RenderOptions& options = RenderOptions());
+
 } // namespace mrv
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+namespace fs = std::filesystem;
+
+#include <nlohmann/json.hpp>
+
+#include <tlCore/StringFormat.h>
+
+#include "mrvCore/mrvHash.h"
+
+#include "mrvFl/mrvSaveCheckpoint.h"
+#include "mrvFl/mrvIO.h"
+
+namespace
+{
+    const char* kModule = "save";
+
+    //! Frames written between saves of the checkpoint file.
+    const size_t kSegmentFrames = 100;
+
+    //! Size and modification time of a frame on disk.
+    struct FrameStamp
+    {
+        int64_t size = -1;
+        int64_t time = 0;
+
+        bool operator==(const FrameStamp& b) const
+        {
+            return size == b.size && time == b.time;
+        }
+    };
+
+    FrameStamp getStamp(const std::string& fileName)
+    {
+        FrameStamp out;
+        std::error_code ec;
+        const auto size = fs::file_size(fileName, ec);
+        if (ec)
+            return out;
+        const auto time = fs::last_write_time(fileName, ec);
+        if (ec)
+            return out;
+        out.size = static_cast<int64_t>(size);
+        out.time = time.time_since_epoch().count();
+        return out;
+    }
+
+    std::string hashSettings(const std::string& value)
+    {
+        return mrv::hashToHex(mrv::hash(value));
+    }
+} // namespace
+
+namespace mrv
+{
+    struct SaveCheckpoint::Private
+    {
+        file::Path path;
+        std::string input;
+        std::string settings;
+        std::string fileName;
+
+        //! Frames written, by frame number.
+        std::map<int64_t, FrameStamp> frames;
+
+        size_t resumed = 0;
+        size_t unsaved = 0;
+
+        std::mutex mutex;
+    };
+
+    SaveCheckpoint::SaveCheckpoint(
+        const file::Path& path, const std::string& input,
+        const SaveOptions& options, const image::Info& outputInfo,
+        const io::Options& ioOptions, const otime::TimeRange& range) :
+        _p(new Private)
+    {
+        TLRENDER_P();
+
+        p.path = path;
+        p.input = input;
+        p.fileName = getFileName(path);
+
+        // Everything that changes the frames written.  Thread counts do
+        // not.
+        std::string settings =
+            string::Format("{0}|{1}|{2}|{3}|{4}|{5}|{6}|{7}|{8}")
+                .arg(path.get())
+                .arg(static_cast<int>(options.annotations))
+                .arg(static_cast<int>(options.resolution))
+                .arg(options.zipCompressionLevel)
+                .arg(options.dwaCompressionLevel)
+                .arg(static_cast<int>(options.noRename))
+                .arg(outputInfo.size)
+                .arg(outputInfo.pixelType)
+                .arg(range);
+        const std::string threadCount = "ThreadCount";
+        for (const auto& i : ioOptions)
+        {
+            const std::string& key = i.first;
+            if (key.size() >= threadCount.size() &&
+                key.compare(
+                    key.size() - threadCount.size(), threadCount.size(),
+                    threadCount) == 0)
+                continue;
+            settings += "|" + key + "=" + i.second;
+        }
+        p.settings = hashSettings(settings);
+
+        // A save interrupted while writing the checkpoint.
+        std::error_code ec;
+        fs::remove(p.fileName + ".tmp", ec);
+
+        std::ifstream ifs(p.fileName);
+        if (!ifs.is_open())
+            return;
+
+        try
+        {
+            nlohmann::json j;
+            ifs >> j;
+            if (j.at("input").get<std::string>() != input ||
+                j.at("settings").get<std::string>() != p.settings)
+            {
+                LOG_INFO(
+                    string::Format(_("Discarding the checkpoint {0}, as it "
+                                     "was saved with other settings."))
+                        .arg(p.fileName));
+                return;
+            }
+
+            for (const auto& frame : j.at("frames"))
+            {
+                const int64_t number = frame.at(0).get<int64_t>();
+                FrameStamp stamp;
+                stamp.size = frame.at(1).get<int64_t>();
+                stamp.time = frame.at(2).get<int64_t>();
+
+                // Frames changed or removed since are rendered again.
+                if (getStamp(path.get(static_cast<int>(number))) == stamp)
+                    p.frames[number] = stamp;
+            }
+            p.resumed = p.frames.size();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING(
+                string::Format(_("Ignoring the checkpoint {0}: {1}"))
+                    .arg(p.fileName)
+                    .arg(e.what()));
+            p.frames.clear();
+        }
+    }
+
+    SaveCheckpoint::~SaveCheckpoint()
+    {
+        TLRENDER_P();
+        std::unique_lock<std::mutex> lock(p.mutex);
+        if (p.unsaved > 0)
+            _save();
+    }
+
+    size_t SaveCheckpoint::resumedFrames() const
+    {
+        return _p->resumed;
+    }
+
+    bool SaveCheckpoint::isDone(const otime::RationalTime& time) const
+    {
+        TLRENDER_P();
+        std::unique_lock<std::mutex> lock(p.mutex);
+        return p.frames.count(std::llround(time.value())) > 0;
+    }
+
+    void SaveCheckpoint::add(const otime::RationalTime& time)
+    {
+        TLRENDER_P();
+        const int64_t number = std::llround(time.value());
+        const FrameStamp stamp =
+            getStamp(p.path.get(static_cast<int>(number)));
+        if (stamp.size < 0)
+            return;
+
+        std::unique_lock<std::mutex> lock(p.mutex);
+        p.frames[number] = stamp;
+        if (++p.unsaved >= kSegmentFrames)
+            _save();
+    }
+
+    void SaveCheckpoint::save()
+    {
+        TLRENDER_P();
+        std::unique_lock<std::mutex> lock(p.mutex);
+        _save();
+    }
+
+    void SaveCheckpoint::finish()
+    {
+        TLRENDER_P();
+        std::unique_lock<std::mutex> lock(p.mutex);
+        std::error_code ec;
+        fs::remove(p.fileName, ec);
+        p.unsaved = 0;
+    }
+
+    std::string SaveCheckpoint::getFileName(const file::Path& path)
+    {
+        return path.getDirectory() + path.getBaseName() + "checkpoint.json";
+    }
+
+    void SaveCheckpoint::_save()
+    {
+        TLRENDER_P();
+
+        nlohmann::json frames = nlohmann::json::array();
+        for (const auto& i : p.frames)
+            frames.push_back({i.first, i.second.size, i.second.time});
+
+        nlohmann::json j;
+        j["input"] = p.input;
+        j["settings"] = p.settings;
+        j["frames"] = frames;
+
+        // Write to a temporary file first, so a crash while saving does
+        // not lose the previous checkpoint.
+        const std::string tmp = p.fileName + ".tmp";
+        {
+            std::ofstream ofs(tmp);
+            if (!ofs.is_open())
+                return;
+            ofs << j.dump() << std::endl;
+            if (ofs.fail())
+                return;
+        }
+        std::error_code ec;
+        fs::rename(tmp, p.fileName, ec);
+        p.unsaved = 0;
+    }
+
+} // namespace mrv
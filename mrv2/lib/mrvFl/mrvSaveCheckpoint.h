@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <tlIO/IO.h>
+
+#include <tlCore/Image.h>
+#include <tlCore/Path.h>
+#include <tlCore/Time.h>
+#include <tlCore/Util.h>
+
+#include "mrvFl/mrvSaveOptions.h"
+
+namespace mrv
+{
+    using namespace tl;
+
+    /**
+     * Progress of the save of an image sequence, kept in a file next to
+     * the frames so an interrupted save can be resumed.
+     *
+     * The size and modification time of each frame written is recorded,
+     * and the file is saved every segment of frames.  When the same input
+     * is saved again to the same sequence with the same settings and
+     * range, frames still on disk with the size and time recorded are not
+     * rendered again.
+     */
+    class SaveCheckpoint
+    {
+    public:
+        /**
+         * Load the checkpoint of a previous save of input to the sequence
+         * of path, if any.  A checkpoint made with other options, output
+         * information or range is discarded.
+         */
+        SaveCheckpoint(
+            const file::Path& path, const std::string& input,
+            const SaveOptions&, const image::Info& outputInfo,
+            const io::Options& ioOptions, const otime::TimeRange& range);
+
+        //! Saves the checkpoint if there are frames not saved.
+        ~SaveCheckpoint();
+
+        //! Number of frames of a previous save that are still valid.
+        size_t resumedFrames() const;
+
+        //! Whether a frame was saved before and did not change on disk.
+        bool isDone(const otime::RationalTime& time) const;
+
+        //! Record a frame as written.  Thread safe.
+        void add(const otime::RationalTime& time);
+
+        //! Save the checkpoint file.  Thread safe.
+        void save();
+
+        //! Remove the checkpoint file, once the save is complete.
+        void finish();
+
+        //! Name of the checkpoint file of an image sequence.
+        static std::string getFileName(const file::Path& path);
+
+    private:
+        void _save();
+
+        TLRENDER_PRIVATE();
+    };
+
+} // namespace mrv
@@ -2,11 +2,14 @@
 // mrv2
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
+#include <algorithm>
+#include <deque>
 #include <string>
 #include <sstream>
 
 #include <tlIO/System.h>
 
+#include <tlCore/Memory.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 #include <tlCore/Time.h>
@@ -24,10 +27,14 @@
 #include "mrvWidgets/mrvProgressReport.h"
 
 #include "mrvGL/mrvGLErrors.h"
+#include "mrvGL/mrvGLFrameReadback.h"
 
 #include "mrvNetwork/mrvTCP.h"
 
+#include "mrvFl/mrvSave.h"
+#include "mrvFl/mrvSaveCheckpoint.h"
 #include "mrvFl/mrvSaveOptions.h"
+#include "mrvFl/mrvSaveQueue.h"
 #include "mrvFl/mrvIO.h"
 
 #include "mrvUI/mrvDesktop.h"
@@ -39,11 +46,67 @@
 namespace
 {
     const char* kModule = "save";
+
+    //! Frames being read back from the GPU while the next ones render.
+    const unsigned kReadbackCount = 3;
+
+    //! Output images waiting to be written while the next frames are read
+    //! back.
+    const unsigned kImageCount = 3;
+
+    //! Smallest I/O cache of a save, which also holds the audio read.
+    const size_t kMinCacheSize = 256 * tl::memory::megabyte;
 }
 
 namespace mrv
 {
 
+    io::Options getSaveIOOptions(const SaveOptions& options)
+    {
+        io::Options out;
+
+#ifdef TLRENDER_FFMPEG
+        out["FFmpeg/WriteProfile"] = getLabel(options.ffmpegProfile);
+        out["FFmpeg/AudioCodec"] = getLabel(options.ffmpegAudioCodec);
+        out["FFmpeg/ThreadCount"] =
+            string::Format("{0}").arg(ffmpeg::threadCount);
+
+        // If we have a preset, send it over.
+        if (!options.ffmpegPreset.empty())
+        {
+            out["FFmpeg/PresetFile"] = options.ffmpegPreset;
+        }
+
+        out["FFmpeg/PixelFormat"] = options.ffmpegPixelFormat;
+        out["FFmpeg/HardwareEncode"] =
+            string::Format("{0}").arg(options.ffmpegHardwareEncode);
+        if (options.ffmpegOverride)
+        {
+            out["FFmpeg/ColorRange"] = options.ffmpegColorRange;
+            out["FFmpeg/ColorSpace"] = options.ffmpegColorSpace;
+            out["FFmpeg/ColorPrimaries"] = options.ffmpegColorPrimaries;
+            out["FFmpeg/ColorTRC"] = options.ffmpegColorTRC;
+        }
+#endif
+
+#ifdef TLRENDER_EXR
+        out["OpenEXR/Compression"] = getLabel(options.exrCompression);
+        out["OpenEXR/PixelType"] = getLabel(options.exrPixelType);
+        {
+            std::stringstream s;
+            s << options.zipCompressionLevel;
+            out["OpenEXR/ZipCompressionLevel"] = s.str();
+        }
+        {
+            std::stringstream s;
+            s << options.dwaCompressionLevel;
+            out["OpenEXR/DWACompressionLevel"] = s.str();
+        }
+#endif
+
+        return out;
+    }
+
     void
     save_movie(const std::string& file, const ViewerUI* ui, SaveOptions options)
     {
@@ -95,14 +158,9 @@ namespace mrv
         try
         {
 
-            tl::io::Options ioOptions;
+            tl::io::Options ioOptions = getSaveIOOptions(options);
 
 #ifdef TLRENDER_FFMPEG
-            ioOptions["FFmpeg/WriteProfile"] = getLabel(options.ffmpegProfile);
-            ioOptions["FFmpeg/AudioCodec"] = getLabel(options.ffmpegAudioCodec);
-            ioOptions["FFmpeg/ThreadCount"] =
-                string::Format("{0}").arg(ffmpeg::threadCount);
-
             // If we are not saving a movie, take speed from the player's
             // current speed.
             {
@@ -115,40 +173,9 @@ namespace mrv
                         string::Format("{0}").arg(speed);
                 }
             }
-
-            // If we have a preset, send it over.
-            if (!options.ffmpegPreset.empty())
-            {
-                ioOptions["FFmpeg/PresetFile"] = options.ffmpegPreset;
-            }
-
-            ioOptions["FFmpeg/PixelFormat"] = options.ffmpegPixelFormat;
-            ioOptions["FFmpeg/HardwareEncode"] =
-                string::Format("{0}").arg(options.ffmpegHardwareEncode);
-            if (options.ffmpegOverride)
-            {
-                ioOptions["FFmpeg/ColorRange"] = options.ffmpegColorRange;
-                ioOptions["FFmpeg/ColorSpace"] = options.ffmpegColorSpace;
-                ioOptions["FFmpeg/ColorPrimaries"] =
-                    options.ffmpegColorPrimaries;
-                ioOptions["FFmpeg/ColorTRC"] = options.ffmpegColorTRC;
-            }
 #endif
 
 #ifdef TLRENDER_EXR
-            ioOptions["OpenEXR/Compression"] = getLabel(options.exrCompression);
-            ioOptions["OpenEXR/PixelType"] = getLabel(options.exrPixelType);
-            {
-                std::stringstream s;
-                s << options.zipCompressionLevel;
-                ioOptions["OpenEXR/ZipCompressionLevel"] = s.str();
-            }
-            {
-                std::stringstream s;
-                s << options.dwaCompressionLevel;
-                ioOptions["OpenEXR/DWACompressionLevel"] = s.str();
-            }
-
             {
                 std::stringstream s;
                 s << speed;
@@ -161,10 +188,6 @@ namespace mrv
             auto Aitem = model->observeA()->get();
             std::string inputFile = Aitem->path.get();
 
-            // Make I/O cache be 1Gb to deal with long movies fine.
-            size_t bytes = memory::gigabyte;
-            cache->setMax(bytes);
-
             auto context = ui->app->getContext();
             auto timeline = player->timeline();
 
@@ -395,7 +418,6 @@ namespace mrv
             image::Info outputInfo;
 
             outputInfo.size = renderSize;
-            std::shared_ptr<image::Image> outputImage;
 
             outputInfo.pixelType = info.video[layerId].pixelType;
 
@@ -515,7 +537,6 @@ namespace mrv
                           .arg(outputInfo.pixelType);
                 LOG_INFO(msg);
 
-                outputImage = image::Image::create(outputInfo);
                 ioInfo.videoTime = videoTime;
                 ioInfo.video.push_back(outputInfo);
 
@@ -543,8 +564,9 @@ namespace mrv
                 ioInfo.audioTime = audioTime;
             }
 
-            auto writer = writerPlugin->write(path, ioInfo, ioOptions);
-            if (!writer)
+            const auto writers = SaveQueue::createWriters(
+                writerPlugin, path, ioInfo, ioOptions);
+            if (writers.empty())
             {
                 throw std::runtime_error(
                     string::Format("{0}: Cannot open").arg(file));
@@ -599,6 +621,7 @@ namespace mrv
                 progress.show();
 
             bool running = true;
+            bool cancelled = false;
 
             // Don't send any tcp updates
             tcp->lock();
@@ -639,6 +662,87 @@ namespace mrv
                     offscreenBufferSize, offscreenBufferOptions);
             }
 
+            // Frames are read back asynchronously and written on a thread
+            // of their own, so decoding, rendering, reading back and
+            // encoding overlap.
+            std::unique_ptr<opengl::FrameReadback> readback;
+            if (hasVideo)
+                readback = std::make_unique<opengl::FrameReadback>(
+                    outputInfo, kReadbackCount);
+
+            // Image sequences keep a checkpoint of the frames written, so
+            // an interrupted save is resumed by saving again.
+            std::unique_ptr<SaveCheckpoint> checkpoint;
+            if (hasVideo && !savingMovie && !savingAudio)
+            {
+                checkpoint = std::make_unique<SaveCheckpoint>(
+                    path, inputFile, options, outputInfo, ioOptions,
+                    timeRange);
+                if (checkpoint->resumedFrames() > 0)
+                {
+                    msg = string::Format(_("Resuming save.  {0} frames were "
+                                           "already saved."))
+                              .arg(checkpoint->resumedFrames());
+                    LOG_INFO(msg);
+                }
+            }
+
+            SaveQueue queue(
+                writers, hasVideo ? outputInfo : image::Info(), kImageCount);
+            if (checkpoint)
+            {
+                queue.setWriteCallback(
+                    [&checkpoint](const otime::RationalTime& time)
+                    { checkpoint->add(time); });
+            }
+
+            // Write the oldest frame read back.  The image goes back to
+            // the pool unless it was queued, even if the read back throws.
+            auto writeFrame = [&]
+            {
+                struct Release
+                {
+                    SaveQueue& queue;
+                    std::shared_ptr<image::Image> image;
+                    ~Release()
+                    {
+                        if (image)
+                            queue.releaseImage(image);
+                    }
+                } release{queue, queue.getImage()};
+
+                const auto time = readback->retrieve(release.image);
+                if (videoTime.contains(time))
+                {
+                    queue.writeVideo(time, release.image);
+                    release.image.reset();
+                }
+            };
+
+            // Video requested ahead of the current frame, so the next
+            // frames decode while this one is saved.
+            const size_t videoRequestCount = std::max(
+                ui->app->settings()->getValue<int>(
+                    "Performance/VideoRequestCount"),
+                1);
+            std::deque<timeline::VideoRequest> videoRequests;
+            auto requestTime = currentTime;
+
+            // Frames are read once and in order, so the I/O cache only
+            // needs to hold the frames requested ahead, however long the
+            // save is.
+            {
+                size_t bytes = kMinCacheSize;
+                if (hasVideo)
+                {
+                    const size_t frameBytes =
+                        image::getDataByteCount(info.video[layerId]);
+                    bytes = std::max(
+                        bytes, frameBytes * (videoRequestCount + 2));
+                }
+                cache->setMax(bytes);
+            }
+
             size_t totalSamples = 0;
             size_t currentSampleCount =
                 startTime.rescaled_to(sampleRate).value();
@@ -650,8 +754,11 @@ namespace mrv
                 // If progress window is closed, exit loop.
                 if (interactive)
                 {
-                    if(!progress.tick())
+                    if (!progress.tick())
+                    {
+                        cancelled = true;
                         break;
+                    }
                 }
                 else
                 {
@@ -722,7 +829,7 @@ namespace mrv
                         {
                             if (!skip)
                             {
-                                writer->writeAudio(range, audio);
+                                queue.writeAudio(range, audio);
 
                                 const size_t sampleCount =
                                     audio->getSampleCount();
@@ -733,7 +840,9 @@ namespace mrv
                     }
                 }
 
-                if (hasVideo)
+                const bool saved =
+                    checkpoint && checkpoint->isDone(currentTime);
+                if (hasVideo && !saved)
                 {
                     if (options.annotations)
                     {
@@ -753,15 +862,26 @@ namespace mrv
                         glReadBuffer(imageBuffer);
 
                         glReadBuffer(GL_FRONT);
-                        glReadPixels(
-                            X, Y, outputInfo.size.w, outputInfo.size.h, format,
-                            type, outputImage->getData());
+                        if (readback->isFull())
+                            writeFrame();
+                        readback->read(X, Y, currentTime);
                     }
                     else
                     {
+                        while (videoRequests.size() < videoRequestCount &&
+                               requestTime <= endTime)
+                        {
+                            if (!checkpoint || !checkpoint->isDone(requestTime))
+                                videoRequests.push_back(
+                                    timeline->getVideo(requestTime));
+                            requestTime +=
+                                otime::RationalTime(1, requestTime.rate());
+                        }
+
                         // Get the videoData
                         const auto videoData =
-                            timeline->getVideo(currentTime).future.get();
+                            videoRequests.front().future.get();
+                        videoRequests.pop_front();
                         if (videoData.layers.empty() ||
                             !videoData.layers[0].image)
                         {
@@ -805,21 +925,10 @@ namespace mrv
                             render->end();
                         }
 
-                        glPixelStorei(
-                            GL_PACK_ALIGNMENT, outputInfo.layout.alignment);
-#if defined(TLRENDER_API_GL_4_1)
-                        glPixelStorei(
-                            GL_PACK_SWAP_BYTES,
-                            outputInfo.layout.endian != memory::getEndian());
-#endif // TLRENDER_API_GL_4_1
-
-                        glReadPixels(
-                            0, 0, outputInfo.size.w, outputInfo.size.h, format,
-                            type, outputImage->getData());
+                        if (readback->isFull())
+                            writeFrame();
+                        readback->read(0, 0, currentTime);
                     }
-
-                    if (videoTime.contains(currentTime))
-                        writer->writeVideo(currentTime, outputImage);
                 }
 
                 if (hasVideo)
@@ -844,6 +953,37 @@ namespace mrv
                         player->seek(currentTime);
                 }
             }
+
+            if (!videoRequests.empty())
+            {
+                std::vector<uint64_t> ids;
+                for (const auto& request : videoRequests)
+                    ids.push_back(request.id);
+                timeline->cancelRequests(ids);
+            }
+
+            if (readback)
+            {
+                if (interactive)
+                    view->make_current();
+                while (readback->size() > 0)
+                    writeFrame();
+            }
+            queue.finish();
+
+            if (checkpoint)
+            {
+                if (cancelled)
+                {
+                    checkpoint->save();
+                    LOG_INFO(_("Save interrupted.  Save again to the same "
+                               "file to resume it."));
+                }
+                else
+                {
+                    checkpoint->finish();
+                }
+            }
         }
         catch (const std::exception& e)
         {
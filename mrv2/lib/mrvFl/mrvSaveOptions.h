@@ -4,6 +4,11 @@
 
 #pragma once
 
+#include <tlTimeline/LUTOptions.h>
+#include <tlTimeline/OCIOOptions.h>
+
+#include <tlCore/Time.h>
+
 #ifdef TLRENDER_FFMPEG
 #    include <tlIO/FFmpeg.h>
 #endif
@@ -44,4 +49,14 @@ namespace mrv
 
         bool noRename = false;
     };
+
+    //! Options of a render from the command-line.
+    struct RenderOptions
+    {
+        std::string audioFileName;
+        tl::otime::TimeRange inOutRange = tl::time::invalidTimeRange;
+        tl::timeline::OCIOOptions ocioOptions;
+        tl::timeline::LUTOptions lutOptions;
+        SaveOptions saveOptions;
+    };
 } // namespace mrv
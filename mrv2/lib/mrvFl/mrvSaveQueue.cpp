@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "mrvCore/mrvFile.h"
+
+#include "mrvFl/mrvSaveQueue.h"
+
+namespace
+{
+    //! Most writers used for an image sequence.
+    const unsigned kMaxWriterCount = 16;
+} // namespace
+
+namespace mrv
+{
+    struct SaveQueue::Private
+    {
+        struct Job
+        {
+            std::shared_ptr<image::Image> image;
+            otime::RationalTime time;
+            std::shared_ptr<audio::Audio> audio;
+            otime::TimeRange range;
+        };
+
+        std::vector<std::shared_ptr<io::IWrite> > writers;
+        std::function<void(const otime::RationalTime&)> writeCallback;
+
+        std::vector<std::shared_ptr<image::Image> > images;
+        std::deque<Job> jobs;
+        std::exception_ptr error;
+        bool stop = false;
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<std::thread> threads;
+    };
+
+    SaveQueue::SaveQueue(
+        const std::vector<std::shared_ptr<io::IWrite> >& writers,
+        const image::Info& info, const unsigned count) :
+        _p(new Private)
+    {
+        TLRENDER_P();
+
+        p.writers = writers;
+        if (info.isValid())
+        {
+            const size_t imageCount = writers.size() + std::max(count, 1U);
+            for (size_t i = 0; i < imageCount; ++i)
+                p.images.push_back(image::Image::create(info));
+        }
+        for (size_t i = 0; i < writers.size(); ++i)
+            p.threads.push_back(std::thread([this, i] { _run(i); }));
+    }
+
+    SaveQueue::~SaveQueue()
+    {
+        TLRENDER_P();
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.stop = true;
+        }
+        p.cv.notify_all();
+        for (auto& thread : p.threads)
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+    }
+
+    std::shared_ptr<image::Image> SaveQueue::getImage()
+    {
+        TLRENDER_P();
+        std::unique_lock<std::mutex> lock(p.mutex);
+        p.cv.wait(lock, [&p] { return !p.images.empty() || p.error; });
+        if (p.error)
+            std::rethrow_exception(p.error);
+        auto out = p.images.back();
+        p.images.pop_back();
+        return out;
+    }
+
+    void SaveQueue::releaseImage(const std::shared_ptr<image::Image>& value)
+    {
+        TLRENDER_P();
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.images.push_back(value);
+        }
+        p.cv.notify_all();
+    }
+
+    void SaveQueue::writeVideo(
+        const otime::RationalTime& time,
+        const std::shared_ptr<image::Image>& image)
+    {
+        TLRENDER_P();
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            Private::Job job;
+            job.image = image;
+            job.time = time;
+            p.jobs.push_back(job);
+        }
+        p.cv.notify_all();
+    }
+
+    void SaveQueue::setWriteCallback(
+        const std::function<void(const otime::RationalTime&)>& value)
+    {
+        _p->writeCallback = value;
+    }
+
+    void SaveQueue::writeAudio(
+        const otime::TimeRange& range,
+        const std::shared_ptr<audio::Audio>& audio)
+    {
+        TLRENDER_P();
+        {
+            std::unique_lock<std::mutex> lock(p.mutex);
+            Private::Job job;
+            job.audio = audio;
+            job.range = range;
+            p.jobs.push_back(job);
+        }
+        p.cv.notify_all();
+    }
+
+    void SaveQueue::finish()
+    {
+        TLRENDER_P();
+        std::unique_lock<std::mutex> lock(p.mutex);
+        p.stop = true;
+        p.cv.notify_all();
+        lock.unlock();
+
+        for (auto& thread : p.threads)
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+
+        if (p.error)
+            std::rethrow_exception(p.error);
+    }
+
+    std::vector<std::shared_ptr<io::IWrite> > SaveQueue::createWriters(
+        const std::shared_ptr<io::IPlugin>& plugin, const file::Path& path,
+        const io::Info& info, const io::Options& options)
+    {
+        std::vector<std::shared_ptr<io::IWrite> > out;
+        out.push_back(plugin->write(path, info, options));
+        if (!out[0])
+            return {};
+
+        if (info.video.empty() || file::isMovie(path) || file::isAudio(path))
+            return out;
+
+        // Each writer keeps its own options, including the compression
+        // level, so no state is shared between the threads.
+        const unsigned count = std::clamp(
+            std::thread::hardware_concurrency(), 1U, kMaxWriterCount);
+        for (unsigned i = 1; i < count; ++i)
+        {
+            auto writer = plugin->write(path, info, options);
+            if (!writer)
+                break;
+            out.push_back(writer);
+        }
+        return out;
+    }
+
+    void SaveQueue::_run(const size_t index)
+    {
+        TLRENDER_P();
+        const auto& writer = p.writers[index];
+        while (true)
+        {
+            Private::Job job;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.cv.wait(lock, [&p] { return !p.jobs.empty() || p.stop; });
+                if (p.jobs.empty() || p.error)
+                    return;
+                job = p.jobs.front();
+                p.jobs.pop_front();
+            }
+
+            try
+            {
+                if (job.image)
+                {
+                    writer->writeVideo(job.time, job.image);
+                    if (p.writeCallback)
+                        p.writeCallback(job.time);
+                }
+                else if (job.audio)
+                    writer->writeAudio(job.range, job.audio);
+            }
+            catch (...)
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.error = std::current_exception();
+                p.jobs.clear();
+            }
+
+            if (job.image)
+                releaseImage(job.image);
+            else
+                p.cv.notify_all();
+        }
+    }
+
+} // namespace mrv
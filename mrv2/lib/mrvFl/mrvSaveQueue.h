@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <tlIO/IO.h>
+
+#include <tlCore/Audio.h>
+#include <tlCore/Image.h>
+#include <tlCore/Time.h>
+#include <tlCore/Util.h>
+
+namespace mrv
+{
+    using namespace tl;
+
+    /**
+     * Writes the frames and audio of a save on threads of their own, so
+     * encoding overlaps the decoding and rendering of the next frames.
+     *
+     * Frames are written from a small pool of output images.  Getting
+     * an image blocks while all of them are queued or being written,
+     * which bounds the memory used when the writer is slower than the
+     * renderer.
+     *
+     * With a single writer, video and audio are written in the order they
+     * are queued.  With several writers (image sequences), each has a
+     * thread of its own and frames are written in any order.
+     */
+    class SaveQueue
+    {
+    public:
+        /**
+         * @param writers Writers of the same file, each used by a thread.
+         * @param info    Image info of the frames.
+         * @param count   Number of output images waiting to be written,
+         *                in addition to the one each writer holds.
+         */
+        SaveQueue(
+            const std::vector<std::shared_ptr<io::IWrite> >& writers,
+            const image::Info& info, const unsigned count);
+
+        //! Waits for the queued writes to finish.
+        ~SaveQueue();
+
+        /**
+         * Get an output image to fill, waiting for one to be free.
+         * Rethrows the error of a failed write.
+         */
+        std::shared_ptr<image::Image> getImage();
+
+        //! Return an image that was not written to the pool.
+        void releaseImage(const std::shared_ptr<image::Image>&);
+
+        //! Queue a frame.  The image must come from getImage().
+        void writeVideo(
+            const otime::RationalTime&, const std::shared_ptr<image::Image>&);
+
+        //! Set a function called, from the writer threads, after each
+        //! frame is written.  Must be set before queueing frames.
+        void setWriteCallback(
+            const std::function<void(const otime::RationalTime&)>&);
+
+        //! Queue audio.
+        void writeAudio(
+            const otime::TimeRange&, const std::shared_ptr<audio::Audio>&);
+
+        //! Wait for the queued writes to finish and rethrow the error of a
+        //! failed write.
+        void finish();
+
+        /**
+         * Create the writers of a save.  Movies need a single writer, but
+         * the frames of image sequences are independent files, so they
+         * get one writer per thread and are written in parallel.
+         */
+        static std::vector<std::shared_ptr<io::IWrite> > createWriters(
+            const std::shared_ptr<io::IPlugin>& plugin,
+            const file::Path& path, const io::Info& info,
+            const io::Options& options);
+
+    private:
+        void _run(const size_t index);
+
+        TLRENDER_PRIVATE();
+    };
+
+} // namespace mrv
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "mrvFl/mrvScheduler.h"
+
+namespace mrv
+{
+    namespace scheduler
+    {
+        namespace
+        {
+            //! Interval of the timers once idle.
+            const double kIdleInterval = 0.25;
+
+            //! Time without activity before the timers slow down.
+            const std::chrono::seconds kIdleDelay(2);
+
+            struct Timer
+            {
+                Fl_Timeout_Handler handler;
+                void* data;
+                double interval;
+            };
+
+            std::vector<Timer> timers;
+
+            std::chrono::steady_clock::time_point activity =
+                std::chrono::steady_clock::now();
+            bool idle = false;
+
+            std::vector<Timer>::iterator find(Fl_Timeout_Handler h, void* d)
+            {
+                return std::find_if(
+                    timers.begin(), timers.end(), [h, d](const Timer& t)
+                    { return t.handler == h && t.data == d; });
+            }
+
+            int systemHandler(void*, void*)
+            {
+                wakeUp();
+                return 0;
+            }
+
+            //! System handlers are not called by every backend of FLTK
+            //! (Wayland, for one), but all the events are dispatched here.
+            int eventDispatch(int event, Fl_Window* window)
+            {
+                wakeUp();
+                return Fl::handle_(event, window);
+            }
+        } // namespace
+
+        void init()
+        {
+            Fl::add_system_handler(systemHandler, nullptr);
+            Fl::event_dispatch(eventDispatch);
+        }
+
+        void add(Fl_Timeout_Handler handler, void* data, double interval)
+        {
+            auto i = find(handler, data);
+            if (i != timers.end())
+                i->interval = interval;
+            else
+                timers.push_back({handler, data, interval});
+            Fl::add_timeout(idle ? kIdleInterval : interval, handler, data);
+        }
+
+        void remove(Fl_Timeout_Handler handler, void* data)
+        {
+            auto i = find(handler, data);
+            if (i != timers.end())
+                timers.erase(i);
+            Fl::remove_timeout(handler, data);
+        }
+
+        void repeat(Fl_Timeout_Handler handler, void* data)
+        {
+            auto i = find(handler, data);
+            if (i == timers.end())
+                return;
+
+            const auto now = std::chrono::steady_clock::now();
+            if (!idle && now - activity > kIdleDelay)
+                idle = true;
+            Fl::repeat_timeout(
+                idle ? kIdleInterval : i->interval, handler, data);
+        }
+
+        void wakeUp()
+        {
+            activity = std::chrono::steady_clock::now();
+            if (!idle)
+                return;
+
+            // Fire the timers now, as they were waiting for the idle
+            // interval.
+            idle = false;
+            for (const auto& timer : timers)
+            {
+                Fl::remove_timeout(timer.handler, timer.data);
+                Fl::add_timeout(0.0, timer.handler, timer.data);
+            }
+        }
+
+        bool isIdle()
+        {
+            return idle;
+        }
+    } // namespace scheduler
+} // namespace mrv
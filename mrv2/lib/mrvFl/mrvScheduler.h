@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <FL/Fl.H>
+
+namespace mrv
+{
+    /**
+     * Repeating timers of the main loop that slow down when the
+     * application is idle.
+     *
+     * Timers run at their own interval while there is activity (user
+     * input, playback, network messages...) and at kIdleInterval once
+     * there has been none for a while.  When activity resumes, idle
+     * timers are fired right away instead of waiting for their slow
+     * interval to expire.
+     *
+     * All the functions must be called from the main thread.
+     */
+    namespace scheduler
+    {
+        //! Watch the system and FLTK events, so user input counts as
+        //! activity.
+        void init();
+
+        //! Start a repeating timer.
+        void add(Fl_Timeout_Handler, void* data, double interval);
+
+        //! Stop a repeating timer.
+        void remove(Fl_Timeout_Handler, void* data);
+
+        //! Schedule the next call of a timer.  Call it from the timer.
+        void repeat(Fl_Timeout_Handler, void* data);
+
+        //! Note activity, so the timers run at their interval for a while.
+        void wakeUp();
+
+        //! Whether the application has been idle for a while.
+        bool isIdle();
+    } // namespace scheduler
+} // namespace mrv
@@ -12,9 +12,11 @@
 #include "mrvCore/mrvMath.h"
 
 #include "mrvDraw/Annotation.h"
+#include "mrvDraw/AnnotationList.h"
 
 #include "mrvFl/mrvPreferences.h"
 #include "mrvFl/mrvIO.h"
+#include "mrvFl/mrvScheduler.h"
 
 #ifdef TLRENDER_GL
 #    include "mrvGL/mrvTimelineViewport.h"
@@ -75,6 +77,7 @@ namespace mrv
             cacheInfoObserver;
 
         bool isStepping = false;
+        bool observing = false;
 
         //! Measuring timer
 #ifdef DEBUG_SPEED
@@ -82,7 +85,7 @@ namespace mrv
 #endif
 
         //! List of annotations ( drawings/text per time )
-        std::vector<std::shared_ptr<draw::Annotation> > annotations;
+        draw::AnnotationList annotations;
 
         //! Last annotation undone
         std::shared_ptr<draw::Annotation > undoAnnotation = nullptr;
@@ -100,42 +103,13 @@ namespace mrv
             App::ui->uiPrefs->uiPrefsLoopMode->value());
         p.player->setLoop(loop);
 
-        p.speedObserver = observer::ValueObserver<double>::create(
-            p.player->observeSpeed(),
-            [this](double value) { speedChanged(value); });
-
-        p.playbackObserver =
-            observer::ValueObserver<timeline::Playback>::create(
-                p.player->observePlayback(),
-                [this](timeline::Playback value) { playbackChanged(value); });
-
-        p.loopObserver = observer::ValueObserver<timeline::Loop>::create(
-            p.player->observeLoop(),
-            [this](timeline::Loop value) { loopChanged(value); });
-
-        p.currentTimeObserver =
-            observer::ValueObserver<otime::RationalTime>::create(
-                p.player->observeCurrentTime(),
-                [this](const otime::RationalTime& value)
-                { currentTimeChanged(value); });
-
-        p.cacheOptionsObserver =
-            observer::ValueObserver<timeline::PlayerCacheOptions>::create(
-                p.player->observeCacheOptions(),
-                [this](const timeline::PlayerCacheOptions& value)
-                { cacheOptionsChanged(value); });
-
-        p.cacheInfoObserver =
-            observer::ValueObserver<timeline::PlayerCacheInfo>::create(
-                p.player->observeCacheInfo(),
-                [this](const timeline::PlayerCacheInfo& value)
-                { cacheInfoChanged(value); });
+        setObserving(true);
 
 #ifdef DEBUG_SPEED
         p.start_time = std::chrono::high_resolution_clock::now();
 #endif
 
-        Fl::add_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
+        scheduler::add((Fl_Timeout_Handler)timerEvent_cb, this, kTimeout);
     }
 
     TimelinePlayer::TimelinePlayer(
@@ -148,7 +122,7 @@ namespace mrv
 
     TimelinePlayer::~TimelinePlayer()
     {
-        Fl::remove_timeout((Fl_Timeout_Handler)timerEvent_cb, this);
+        scheduler::remove((Fl_Timeout_Handler)timerEvent_cb, this);
     }
 
     const std::weak_ptr<system::Context>& TimelinePlayer::context() const
@@ -559,6 +533,55 @@ namespace mrv
         timelineViewport = view;
     }
 
+    void TimelinePlayer::setObserving(bool value)
+    {
+        TLRENDER_P();
+        if (value == p.observing)
+            return;
+        p.observing = value;
+        if (!value)
+        {
+            p.speedObserver.reset();
+            p.playbackObserver.reset();
+            p.loopObserver.reset();
+            p.currentTimeObserver.reset();
+            p.cacheOptionsObserver.reset();
+            p.cacheInfoObserver.reset();
+            return;
+        }
+
+        p.speedObserver = observer::ValueObserver<double>::create(
+            p.player->observeSpeed(),
+            [this](double value) { speedChanged(value); });
+
+        p.playbackObserver =
+            observer::ValueObserver<timeline::Playback>::create(
+                p.player->observePlayback(),
+                [this](timeline::Playback value) { playbackChanged(value); });
+
+        p.loopObserver = observer::ValueObserver<timeline::Loop>::create(
+            p.player->observeLoop(),
+            [this](timeline::Loop value) { loopChanged(value); });
+
+        p.currentTimeObserver =
+            observer::ValueObserver<otime::RationalTime>::create(
+                p.player->observeCurrentTime(),
+                [this](const otime::RationalTime& value)
+                { currentTimeChanged(value); });
+
+        p.cacheOptionsObserver =
+            observer::ValueObserver<timeline::PlayerCacheOptions>::create(
+                p.player->observeCacheOptions(),
+                [this](const timeline::PlayerCacheOptions& value)
+                { cacheOptionsChanged(value); });
+
+        p.cacheInfoObserver =
+            observer::ValueObserver<timeline::PlayerCacheInfo>::create(
+                p.player->observeCacheInfo(),
+                [this](const timeline::PlayerCacheInfo& value)
+                { cacheInfoChanged(value); });
+    }
+
     //! \name Playback
     ///@{
 
@@ -623,14 +646,7 @@ namespace mrv
     const std::vector< otime::RationalTime >
     TimelinePlayer::getAnnotationTimes() const
     {
-        TLRENDER_P();
-
-        std::vector< otime::RationalTime > times;
-        for (auto annotation : p.annotations)
-        {
-            times.push_back(annotation->time);
-        }
-        return times;
+        return _p->annotations.times();
     }
 
     std::vector< std::shared_ptr< draw::Annotation > >
@@ -644,30 +660,9 @@ namespace mrv
             static_cast<double>(previous), time.rate());
         otime::RationalTime nextTime(static_cast<double>(next), time.rate());
 
-        std::vector< std::shared_ptr< draw::Annotation > > annotations;
-
-        auto found = p.annotations.begin();
-
-        while (found != p.annotations.end())
-        {
-            found = std::find_if(
-                found, p.annotations.end(),
-                [time, previousTime, nextTime](const auto& a)
-                {
-                    if (a->allFrames)
-                        return true;
-                    const otime::RationalTime start = a->time - previousTime;
-                    const otime::RationalTime end = a->time + nextTime;
-                    return (time > start && time < end);
-                });
-
-            if (found != p.annotations.end())
-            {
-                annotations.push_back(*found);
-                ++found;
-            }
-        }
-        return annotations;
+        // An annotation is shown when time is in
+        // (annotation - previous, annotation + next).
+        return p.annotations.find(time - nextTime, time + previousTime);
     }
 
     std::shared_ptr< draw::Annotation > TimelinePlayer::getAnnotation() const
@@ -678,20 +673,7 @@ namespace mrv
         if (playback() != timeline::Playback::Stop)
             return nullptr;
 
-        const auto& time = currentTime();
-
-        const auto found = std::find_if(
-            p.annotations.begin(), p.annotations.end(),
-            [time](const auto& a) { return a->time == time; });
-
-        if (found == p.annotations.end())
-        {
-            return nullptr;
-        }
-        else
-        {
-            return *found;
-        }
+        return p.annotations.find(currentTime());
     }
 
     std::shared_ptr< draw::Annotation >
@@ -707,15 +689,11 @@ namespace mrv
 
         auto time = currentTime();
 
-        auto found = std::find_if(
-            p.annotations.begin(), p.annotations.end(),
-            [time](const auto& a) { return a->time == time; });
-
-        if (found == p.annotations.end())
+        auto annotation = p.annotations.find(time);
+        if (!annotation)
         {
-            auto annotation =
-                std::make_shared< draw::Annotation >(time, all_frames);
-            p.annotations.push_back(annotation);
+            annotation = std::make_shared< draw::Annotation >(time, all_frames);
+            p.annotations.add(annotation);
             bool send = App::ui->uiPrefs->SendAnnotations->value();
             if (send)
                 tcp->pushMessage("Create Annotation", all_frames);
@@ -723,7 +701,6 @@ namespace mrv
         }
         else
         {
-            auto annotation = *found;
             if (!annotation->allFrames && !all_frames)
             {
                 throw std::runtime_error(
@@ -737,28 +714,23 @@ namespace mrv
     std::vector< std::shared_ptr< draw::Annotation >>
     TimelinePlayer::getAllAnnotations() const
     {
-        return _p->annotations;
+        return _p->annotations.all();
     }
 
     void TimelinePlayer::setAllAnnotations(
         const std::vector< std::shared_ptr< draw::Annotation >>& value)
     {
-        _p->annotations = value;
+        _p->annotations.set(value);
     }
 
     void TimelinePlayer::clearFrameAnnotation()
     {
         TLRENDER_P();
 
-        const auto& time = currentTime();
-
-        auto found = std::find_if(
-            p.annotations.begin(), p.annotations.end(),
-            [time](const auto& a) { return a->time == time; });
-
-        if (found != p.annotations.end())
+        auto annotation = p.annotations.find(currentTime());
+        if (annotation)
         {
-            p.annotations.erase(found);
+            p.annotations.remove(annotation);
         }
     }
 
@@ -772,9 +744,7 @@ namespace mrv
     {
         TLRENDER_P();
 
-        p.annotations.erase(
-            std::remove(p.annotations.begin(), p.annotations.end(), annotation),
-            p.annotations.end());
+        p.annotations.remove(annotation);
     }
 
     void TimelinePlayer::undoAnnotation()
@@ -804,7 +774,7 @@ namespace mrv
             if (p.undoAnnotation)
             {
                 annotation = p.undoAnnotation;
-                p.annotations.push_back(annotation);
+                p.annotations.add(annotation);
                 p.undoAnnotation.reset();
             }
         }
@@ -855,7 +825,12 @@ namespace mrv
         _p->start_time = std::chrono::high_resolution_clock::now();
 #endif
         _p->player->tick();
-        Fl::repeat_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
+
+        // Keep the timers at full rate while playing.
+        if (_p->player->observePlayback()->get() != timeline::Playback::Stop)
+            scheduler::wakeUp();
+
+        scheduler::repeat((Fl_Timeout_Handler)timerEvent_cb, this);
     }
 
     void TimelinePlayer::timerEvent_cb(void* d)
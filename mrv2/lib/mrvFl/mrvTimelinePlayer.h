@@ -329,6 +329,10 @@ namespace mrv
 
         void setTimelineViewport(TimelineViewport*);
 
+        //! Set whether the player updates the user interface.  Players
+        //! kept warm in the background do not.
+        void setObserving(bool);
+
         ///@}
 
         //! Returns whether there's annotations in the player
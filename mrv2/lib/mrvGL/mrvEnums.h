@@ -34,6 +34,7 @@ namespace mrv
         kMemory = 1 << 8,
         kCache = 1 << 9,
         kAttributes = 1 << 10,
+        kReadback = 1 << 11,
     };
 
     enum MissingFrameType { kBlackFrame, kRepeatFrame, kScratchedFrame };
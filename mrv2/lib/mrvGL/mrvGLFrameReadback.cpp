@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <tlCore/Memory.h>
+
+#include <tlGL/Util.h>
+
+#include "mrvGL/mrvGLErrors.h"
+#include "mrvGL/mrvGLFrameReadback.h"
+
+namespace
+{
+    //! Longest wait for a read, in nanoseconds.
+    const GLuint64 kWaitTimeout = 10000000000;
+
+    const unsigned kMinCount = 2;
+    const unsigned kMaxCount = 8;
+} // namespace
+
+namespace mrv
+{
+    namespace opengl
+    {
+        struct FrameReadback::Private
+        {
+            struct Slot
+            {
+                GLuint id = 0;
+                GLsync fence = nullptr;
+                otime::RationalTime time;
+            };
+
+            image::Info info;
+            GLenum format = GL_NONE;
+            GLenum type = GL_NONE;
+            size_t dataSize = 0;
+
+            std::vector<Slot> slots;
+
+            //! Oldest read and number of reads in flight.
+            unsigned head = 0;
+            unsigned size = 0;
+        };
+
+        FrameReadback::FrameReadback(
+            const image::Info& info, const unsigned count) :
+            _p(new Private)
+        {
+            TLRENDER_P();
+
+            p.info = info;
+            p.format = gl::getReadPixelsFormat(info.pixelType);
+            p.type = gl::getReadPixelsType(info.pixelType);
+            p.dataSize = image::getDataByteCount(info);
+
+            p.slots.resize(std::clamp(count, kMinCount, kMaxCount));
+            for (auto& slot : p.slots)
+            {
+                glGenBuffers(1, &slot.id);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.id);
+                glBufferData(
+                    GL_PIXEL_PACK_BUFFER, p.dataSize, 0, GL_STREAM_READ);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            CHECK_GL;
+        }
+
+        FrameReadback::~FrameReadback()
+        {
+            TLRENDER_P();
+            for (auto& slot : p.slots)
+            {
+                if (slot.fence)
+                    glDeleteSync(slot.fence);
+                glDeleteBuffers(1, &slot.id);
+            }
+        }
+
+        unsigned FrameReadback::size() const noexcept
+        {
+            return _p->size;
+        }
+
+        bool FrameReadback::isFull() const noexcept
+        {
+            return _p->size == _p->slots.size();
+        }
+
+        void FrameReadback::read(
+            const int X, const int Y, const otime::RationalTime& time)
+        {
+            TLRENDER_P();
+
+            if (isFull())
+                throw std::runtime_error("Frame readback queue is full.");
+
+            const unsigned count = p.slots.size();
+            auto& slot = p.slots[(p.head + p.size) % count];
+
+            glPixelStorei(GL_PACK_ALIGNMENT, p.info.layout.alignment);
+#if defined(TLRENDER_API_GL_4_1)
+            glPixelStorei(
+                GL_PACK_SWAP_BYTES,
+                p.info.layout.endian != memory::getEndian());
+#endif // TLRENDER_API_GL_4_1
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.id);
+            glReadPixels(
+                X, Y, p.info.size.w, p.info.size.h, p.format, p.type, 0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            CHECK_GL;
+
+            slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            slot.time = time;
+            ++p.size;
+        }
+
+        otime::RationalTime
+        FrameReadback::retrieve(const std::shared_ptr<image::Image>& image)
+        {
+            TLRENDER_P();
+
+            if (p.size == 0)
+                throw std::runtime_error("Frame readback queue is empty.");
+
+            auto& slot = p.slots[p.head];
+            p.head = (p.head + 1) % p.slots.size();
+            --p.size;
+
+            if (slot.fence)
+            {
+                const GLenum result = glClientWaitSync(
+                    slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, kWaitTimeout);
+                glDeleteSync(slot.fence);
+                slot.fence = nullptr;
+                if (result != GL_ALREADY_SIGNALED &&
+                    result != GL_CONDITION_SATISFIED)
+                    throw std::runtime_error("Frame readback timed out.");
+            }
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.id);
+            const void* data = glMapBufferRange(
+                GL_PIXEL_PACK_BUFFER, 0, p.dataSize, GL_MAP_READ_BIT);
+            if (data)
+            {
+                memcpy(
+                    image->getData(), data,
+                    std::min(p.dataSize, image->getDataByteCount()));
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            if (!data)
+                throw std::runtime_error("Could not map frame readback.");
+
+            return slot.time;
+        }
+
+    } // namespace opengl
+} // namespace mrv
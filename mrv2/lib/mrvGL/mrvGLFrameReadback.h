@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <memory>
+
+#include <tlCore/Util.h>
+#include <tlCore/Image.h>
+#include <tlCore/Time.h>
+
+namespace mrv
+{
+    namespace opengl
+    {
+        using namespace tl;
+
+        /**
+         * First in, first out queue of asynchronous reads of whole frames
+         * of the bound framebuffer, in the pixel type of an image.
+         *
+         * Unlike Readback, which maps the most recent read and drops old
+         * ones, every read is kept until it is retrieved, so it can be
+         * used to save all the frames of a movie while the GPU renders
+         * the next ones.
+         */
+        class FrameReadback
+        {
+        public:
+            /**
+             * @param info  Size, pixel type and layout of the frames.
+             * @param count Number of reads that can be in flight (2 to 8).
+             */
+            FrameReadback(const image::Info& info, const unsigned count);
+
+            //! Releases the buffers.  Needs the context of the reads.
+            ~FrameReadback();
+
+            //! Number of reads that were not retrieved yet.
+            unsigned size() const noexcept;
+
+            //! Whether all the buffers hold reads not retrieved yet.
+            bool isFull() const noexcept;
+
+            //! Queue a read of the bound read framebuffer at X, Y.
+            void read(const int X, const int Y, const otime::RationalTime&);
+
+            /**
+             * Wait for the oldest read and copy its pixels into image,
+             * which must have the info of the queue.
+             *
+             * @return the time of the read.
+             */
+            otime::RationalTime
+            retrieve(const std::shared_ptr<image::Image>& image);
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+
+    } // namespace opengl
+} // namespace mrv
@@ -2,12 +2,18 @@
 // mrv2
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
 #include <tlCore/Mesh.h>
 
 #include <tlGL/Mesh.h>
 #include <tlGL/Util.h>
 #include <tlGL/Shader.h>
 
+#include "mrvCore/mrvHash.h"
+
 #include "mrvGL/mrvGLErrors.h"
 #include "mrvGL/mrvGLShaders.h"
 #include "mrvGL/mrvGLLines.h"
@@ -35,8 +41,79 @@ namespace mrv
             std::shared_ptr<gl::Shader> hardShader = nullptr;
             std::shared_ptr<gl::VBO> vbo;
             std::shared_ptr<gl::VAO> vao;
+
+            //! Mesh of a shape kept on the GPU between draws.
+            struct Mesh
+            {
+                uint64_t signature = 0;
+                std::shared_ptr<gl::VBO> vbo;
+                std::shared_ptr<gl::VAO> vao;
+
+                //! Whether the mesh was drawn since the last collect().
+                bool used = true;
+            };
+            std::unordered_map<uint64_t, Mesh> meshes;
+
+            //! Stroke tessellated incrementally, in a VBO that grows.
+            struct Stroke
+            {
+                draw::Polyline2D path;
+                float width = 0.F;
+                bool soft = false;
+                draw::Polyline2D::JointStyle jointStyle;
+                draw::Polyline2D::EndCapStyle endStyle;
+
+                //! Input points appended to the path and the first and
+                //! last of them, to know if the stroke only grew.
+                size_t count = 0;
+                draw::Point first;
+                draw::Point last;
+
+                std::shared_ptr<gl::VBO> vbo;
+                std::shared_ptr<gl::VAO> vao;
+
+                //! Number of vertices uploaded to the VBO.
+                size_t size = 0;
+
+                //! Whether the stroke was drawn since the last collect().
+                bool used = true;
+            };
+            std::unordered_map<uint64_t, Stroke> strokes;
+
+            void createShaders();
+            void bindShader(
+                const std::shared_ptr<timeline::IRender>& render,
+                const image::Color4f& color, const bool soft);
         };
 
+        void Lines::Private::createShaders()
+        {
+            if (softShader)
+                return;
+
+            const std::string& vertexSource = tl::timeline_gl::vertexSource();
+            softShader =
+                gl::Shader::create(vertexSource, mrv::softFragmentSource());
+            hardShader =
+                gl::Shader::create(vertexSource, mrv::hardFragmentSource());
+        }
+
+        void Lines::Private::bindShader(
+            const std::shared_ptr<timeline::IRender>& render,
+            const image::Color4f& color, const bool soft)
+        {
+            createShaders();
+
+            const math::Matrix4x4f& mvp = render->getTransform();
+            const auto& shader = soft ? softShader : hardShader;
+            shader->bind();
+            CHECK_GL;
+            shader->setUniform("transform.mvp", mvp);
+            CHECK_GL;
+            shader->setUniform("color", color);
+            CHECK_GL;
+        }
+
         Lines::Lines() :
             _p(new Private)
         {
@@ -44,33 +121,13 @@ namespace mrv
 
         Lines::~Lines() {}
 
-        void Lines::drawLines(
-            const std::shared_ptr<timeline::IRender>& render,
-            const draw::PointList& pts, const image::Color4f& color,
+        void Lines::tessellate(
+            geom::TriangleMesh2& mesh, const draw::PointList& pts,
             const float width, const bool soft,
             const draw::Polyline2D::JointStyle jointStyle,
             const draw::Polyline2D::EndCapStyle endStyle,
             const bool catmullRomSpline, const bool allowOverlap)
         {
-            TLRENDER_P();
-
-            if (!p.softShader)
-            {
-                try
-                {
-                    const std::string& vertexSource =
-                        tl::timeline_gl::vertexSource();
-                    p.softShader = gl::Shader::create(
-                        vertexSource, mrv::softFragmentSource());
-                    p.hardShader = gl::Shader::create(
-                        vertexSource, mrv::hardFragmentSource());
-                }
-                catch (const std::exception& e)
-                {
-                    throw e;
-                }
-            }
-
             using namespace mrv::draw;
 
             Polyline2D path;
@@ -83,77 +140,89 @@ namespace mrv
             const Polyline2D::UVList& uvs = path.getUVs();
             const Polyline2D::TriangleList& triangles = path.getTriangles();
 
-            geom::TriangleMesh2 mesh;
-
             size_t numVertices = draw.size();
             size_t numTriangles = triangles.size();
             size_t numUVs = uvs.size();
 
             // Verify data in debug mode
-            assert(numTriangles > 0);
-            assert(numVertices > 0);
             assert(numUVs == 0 || numUVs == numVertices);
 
-            mesh.triangles.reserve(numTriangles);
+            // Mesh indices start at 1 and strokes are appended after the
+            // vertices already in the mesh.
+            const size_t offset = mesh.v.size() + 1;
+            const Polyline2D::IndexTriangle first(offset, offset, offset);
+
+            mesh.triangles.reserve(mesh.triangles.size() + numTriangles);
 
-            tl::gl::VBOType vboType = gl::VBOType::Pos2_F32;
             geom::Triangle2 triangle;
-            if (numUVs > 0)
+            for (size_t i = 0; i < numTriangles; ++i)
             {
-                vboType = gl::VBOType::Pos2_F32_UV_U16;
-                for (size_t i = 0; i < numTriangles; ++i)
+                Polyline2D::IndexTriangle t = triangles[i];
+                t += first;
+                triangle.v[0].v = t[0];
+                triangle.v[1].v = t[1];
+                triangle.v[2].v = t[2];
+                if (numUVs > 0)
                 {
-                    Polyline2D::IndexTriangle t = triangles[i];
-                    t += Polyline2D::IndexTriangle(1, 1, 1);
-                    triangle.v[0].v = t[0];
-                    triangle.v[1].v = t[1];
-                    triangle.v[2].v = t[2];
                     triangle.v[0].t = t[0];
                     triangle.v[1].t = t[1];
                     triangle.v[2].t = t[2];
-                    mesh.triangles.push_back(triangle);
-                }
-                mesh.t.reserve(numUVs);
-                for (size_t i = 0; i < numUVs; ++i)
-                    mesh.t.push_back(math::Vector2f(uvs[i].x, uvs[i].y));
-            }
-            else
-            {
-                for (size_t i = 0; i < numTriangles; ++i)
-                {
-                    Polyline2D::IndexTriangle t = triangles[i];
-                    t += Polyline2D::IndexTriangle(1, 1, 1);
-                    triangle.v[0].v = t[0];
-                    triangle.v[1].v = t[1];
-                    triangle.v[2].v = t[2];
-                    mesh.triangles.push_back(triangle);
                 }
+                mesh.triangles.push_back(triangle);
             }
 
-            mesh.v.reserve(numVertices);
+            mesh.t.reserve(mesh.t.size() + numUVs);
+            for (size_t i = 0; i < numUVs; ++i)
+                mesh.t.push_back(math::Vector2f(uvs[i].x, uvs[i].y));
+
+            mesh.v.reserve(mesh.v.size() + numVertices);
             for (size_t i = 0; i < numVertices; ++i)
                 mesh.v.push_back(math::Vector2f(draw[i].x, draw[i].y));
+        }
 
-            const math::Matrix4x4f& mvp = render->getTransform();
-            CHECK_GL;
-            if (soft)
-            {
-                p.softShader->bind();
-                CHECK_GL;
-                p.softShader->setUniform("transform.mvp", mvp);
-                CHECK_GL;
-                p.softShader->setUniform("color", color);
-                CHECK_GL;
-            }
-            else
+        uint64_t Lines::signature(
+            const draw::PointList& pts, const float width, const bool soft)
+        {
+            // A hash of the points, which is much cheaper than tessellating
+            // them again.
+            uint64_t out = mrv::kHashSeed;
+            for (const auto& pt : pts)
             {
-                p.hardShader->bind();
-                CHECK_GL;
-                p.hardShader->setUniform("transform.mvp", mvp);
-                CHECK_GL;
-                p.hardShader->setUniform("color", color);
-                CHECK_GL;
+                out = mrv::hash(&pt.x, sizeof(pt.x), out);
+                out = mrv::hash(&pt.y, sizeof(pt.y), out);
             }
+            out = mrv::hash(&width, sizeof(width), out);
+            out = mrv::hash(&soft, sizeof(soft), out);
+            return out;
+        }
+
+        void Lines::drawLines(
+            const std::shared_ptr<timeline::IRender>& render,
+            const draw::PointList& pts, const image::Color4f& color,
+            const float width, const bool soft,
+            const draw::Polyline2D::JointStyle jointStyle,
+            const draw::Polyline2D::EndCapStyle endStyle,
+            const bool catmullRomSpline, const bool allowOverlap)
+        {
+            TLRENDER_P();
+
+            geom::TriangleMesh2 mesh;
+            tessellate(
+                mesh, pts, width, soft, jointStyle, endStyle, catmullRomSpline,
+                allowOverlap);
+
+            const size_t numTriangles = mesh.triangles.size();
+
+            // Verify data in debug mode
+            assert(numTriangles > 0);
+            assert(mesh.v.size() > 0);
+
+            const tl::gl::VBOType vboType = mesh.t.empty()
+                                                ? gl::VBOType::Pos2_F32
+                                                : gl::VBOType::Pos2_F32_UV_U16;
+
+            CHECK_GL;
+            p.bindShader(render, color, soft);
 
             if (!p.vbo || (p.vbo && (p.vbo->getSize() != numTriangles * 3 ||
                                      p.vbo->getType() != vboType)))
@@ -182,26 +251,194 @@ namespace mrv
                 CHECK_GL;
                 p.vao->draw(GL_TRIANGLES, 0, p.vbo->getSize());
                 CHECK_GL;
+            }
+        }
+
+        void Lines::drawMesh(
+            const std::shared_ptr<timeline::IRender>& render,
+            const uint64_t key, const uint64_t signature,
+            const std::function<void(geom::TriangleMesh2&)>& build,
+            const image::Color4f& color, const bool soft)
+        {
+            TLRENDER_P();
 
-                // #ifndef NDEBUG
-                //             if (!soft)
-                //             {
-                //                 p.wireShader->bind();
-                //                 CHECK_GL;
-                //                 p.wireShader->setUniform("transform.mvp",
-                //                 mvp); CHECK_GL;
-                //                 p.wireShader->setUniform("color",
-                //                 image::Color4f(1, 0, 0, 1)); CHECK_GL;
-                //                 glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-                //                 CHECK_GL;
-                //                 p.vao->bind();
-                //                 CHECK_GL;
-                //                 p.vao->draw(GL_TRIANGLES, 0,
-                //                 p.vbo->getSize()); CHECK_GL;
-                //                 glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-                //                 CHECK_GL;
-                //             }
-                // #endif
+            auto& cached = p.meshes[key];
+            cached.used = true;
+            if (!cached.vbo || cached.signature != signature)
+            {
+                geom::TriangleMesh2 mesh;
+                build(mesh);
+                if (mesh.triangles.empty())
+                {
+                    p.meshes.erase(key);
+                    return;
+                }
+
+                const size_t size = mesh.triangles.size() * 3;
+                const tl::gl::VBOType vboType =
+                    mesh.t.empty() ? gl::VBOType::Pos2_F32
+                                   : gl::VBOType::Pos2_F32_UV_U16;
+                if (!cached.vbo || cached.vbo->getSize() != size ||
+                    cached.vbo->getType() != vboType)
+                {
+                    cached.vbo = gl::VBO::create(size, vboType);
+                    CHECK_GL;
+                    cached.vao =
+                        gl::VAO::create(vboType, cached.vbo->getID());
+                    CHECK_GL;
+                }
+                cached.vbo->copy(convert(mesh, vboType));
+                CHECK_GL;
+                cached.signature = signature;
+            }
+
+            p.bindShader(render, color, soft);
+
+            cached.vao->bind();
+            CHECK_GL;
+            cached.vao->draw(GL_TRIANGLES, 0, cached.vbo->getSize());
+            CHECK_GL;
+        }
+
+        void Lines::drawStroke(
+            const std::shared_ptr<timeline::IRender>& render,
+            const uint64_t key, const draw::PointList& pts,
+            const image::Color4f& color, const float width, const bool soft,
+            const draw::Polyline2D::JointStyle jointStyle,
+            const draw::Polyline2D::EndCapStyle endStyle)
+        {
+            TLRENDER_P();
+
+            if (pts.empty())
+                return;
+
+            auto& stroke = p.strokes[key];
+            stroke.used = true;
+
+            // Start over unless points were only appended.
+            const size_t count = stroke.count;
+            if (count == 0 || pts.size() < count || stroke.width != width ||
+                stroke.soft != soft || stroke.jointStyle != jointStyle ||
+                stroke.endStyle != endStyle || pts[0] != stroke.first ||
+                pts[count - 1] != stroke.last)
+            {
+                stroke.width = width;
+                stroke.soft = soft;
+                stroke.jointStyle = jointStyle;
+                stroke.endStyle = endStyle;
+                stroke.path.setWidth(width);
+                stroke.path.setSoftEdges(soft);
+                stroke.path.begin(jointStyle, endStyle);
+                stroke.count = 0;
+                stroke.size = 0;
+            }
+
+            size_t firstChanged = stroke.size / 3;
+            for (size_t i = stroke.count; i < pts.size(); ++i)
+            {
+                stroke.path.append(pts[i]);
+                firstChanged = std::min(
+                    firstChanged, stroke.path.getFirstChangedTriangle());
+            }
+            stroke.count = pts.size();
+            stroke.first = pts.front();
+            stroke.last = pts.back();
+
+            const auto& triangles = stroke.path.getTriangles();
+            if (triangles.empty())
+                return;
+
+            const size_t size = triangles.size() * 3;
+            const tl::gl::VBOType vboType =
+                soft ? gl::VBOType::Pos2_F32_UV_U16 : gl::VBOType::Pos2_F32;
+            if (!stroke.vbo || stroke.vbo->getSize() < size ||
+                stroke.vbo->getType() != vboType)
+            {
+                // Grow the VBO geometrically, so long strokes are not
+                // uploaded again at every point.
+                stroke.vbo =
+                    gl::VBO::create(std::max<size_t>(size * 2, 768), vboType);
+                CHECK_GL;
+                stroke.vao = gl::VAO::create(vboType, stroke.vbo->getID());
+                CHECK_GL;
+                firstChanged = 0;
+            }
+
+            if (firstChanged < triangles.size())
+            {
+                // Triangles only use the vertices emitted with them, so the
+                // changed triangles use the vertices from the smallest
+                // index on.
+                const auto& vertices = stroke.path.getVertices();
+                const auto& uvs = stroke.path.getUVs();
+                size_t firstVertex = vertices.size();
+                for (size_t i = firstChanged; i < triangles.size(); ++i)
+                {
+                    const auto& t = triangles[i];
+                    firstVertex = std::min({firstVertex, t.x, t.y, t.z});
+                }
+
+                geom::TriangleMesh2 mesh;
+                mesh.v.reserve(vertices.size() - firstVertex);
+                for (size_t i = firstVertex; i < vertices.size(); ++i)
+                    mesh.v.push_back(
+                        math::Vector2f(vertices[i].x, vertices[i].y));
+                for (size_t i = firstVertex; i < uvs.size(); ++i)
+                    mesh.t.push_back(math::Vector2f(uvs[i].x, uvs[i].y));
+
+                const size_t offset = firstVertex - 1;
+                geom::Triangle2 triangle;
+                mesh.triangles.reserve(triangles.size() - firstChanged);
+                for (size_t i = firstChanged; i < triangles.size(); ++i)
+                {
+                    const auto& t = triangles[i];
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        triangle.v[k].v = t[k] - offset;
+                        if (soft)
+                            triangle.v[k].t = t[k] - offset;
+                    }
+                    mesh.triangles.push_back(triangle);
+                }
+
+                const std::vector<uint8_t> data = convert(mesh, vboType);
+                stroke.vbo->copy(
+                    data, firstChanged * 3 * gl::getByteCount(vboType),
+                    data.size());
+                CHECK_GL;
+            }
+            stroke.size = size;
+
+            p.bindShader(render, color, soft);
+
+            stroke.vao->bind();
+            CHECK_GL;
+            stroke.vao->draw(GL_TRIANGLES, 0, size);
+            CHECK_GL;
+        }
+
+        void Lines::collect()
+        {
+            TLRENDER_P();
+            for (auto i = p.meshes.begin(); i != p.meshes.end();)
+            {
+                if (!i->second.used)
+                {
+                    i = p.meshes.erase(i);
+                    continue;
+                }
+                i->second.used = false;
+                ++i;
+            }
+            for (auto i = p.strokes.begin(); i != p.strokes.end();)
+            {
+                if (!i->second.used)
+                {
+                    i = p.strokes.erase(i);
+                    continue;
+                }
+                i->second.used = false;
+                ++i;
             }
         }
 
@@ -257,10 +494,8 @@ namespace mrv
             }
         }
 
-        void Lines::drawCircle(
-            const std::shared_ptr<timeline::IRender>& render,
-            const math::Vector2f& center, const float radius, const float width,
-            const image::Color4f& color, const bool soft)
+        draw::PointList
+        Lines::circle(const math::Vector2f& center, const float radius)
         {
             const int triangleAmount = 30;
             const double twoPi = math::pi * 2.0;
@@ -274,9 +509,16 @@ namespace mrv
                     center.y + (radius * sin(i * twoPi / triangleAmount)));
                 verts.push_back(pt);
             }
+            return verts;
+        }
 
+        void Lines::drawCircle(
+            const std::shared_ptr<timeline::IRender>& render,
+            const math::Vector2f& center, const float radius, const float width,
+            const image::Color4f& color, const bool soft)
+        {
             drawLines(
-                render, verts, color, width, soft,
+                render, circle(center, radius), color, width, soft,
                 draw::Polyline2D::JointStyle::ROUND,
                 draw::Polyline2D::EndCapStyle::JOINT);
         }
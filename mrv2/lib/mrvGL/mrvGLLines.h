@@ -4,7 +4,10 @@
 
 #pragma once
 
+#include <functional>
+
 #include <tlCore/Util.h>
+#include <tlCore/Mesh.h>
 #include <tlCore/Matrix.h>
 #include <tlCore/Color.h>
 
@@ -48,6 +51,59 @@ namespace mrv
                 const bool catmullRomSpline = false,
                 const bool allowOverlap = false);
 
+            /**
+             * Draw a mesh kept on the GPU under key (usually the id of the
+             * shape the mesh belongs to).  The mesh is only built again, with
+             * build, when signature changes.
+             */
+            void drawMesh(
+                const std::shared_ptr<timeline::IRender>& render,
+                const uint64_t key, const uint64_t signature,
+                const std::function<void(geom::TriangleMesh2&)>& build,
+                const image::Color4f& color, const bool soft = false);
+
+            /**
+             * Draw a set of connected line segments that grows while it
+             * is drawn (a pen stroke), keeping it on the GPU under key.
+             * When points were only appended since the last draw, just the
+             * end of the stroke is tessellated and uploaded again.
+             */
+            void drawStroke(
+                const std::shared_ptr<timeline::IRender>& render,
+                const uint64_t key, const draw::PointList& pts,
+                const image::Color4f& color, const float width,
+                const bool soft = false,
+                const draw::Polyline2D::JointStyle jointStyle =
+                    draw::Polyline2D::JointStyle::ROUND,
+                const draw::Polyline2D::EndCapStyle endStyle =
+                    draw::Polyline2D::EndCapStyle::ROUND);
+
+            //! Release the meshes and strokes that were not drawn since the
+            //! last call.
+            void collect();
+
+            //! Tessellate a set of connected line segments, appending them
+            //! to a mesh.
+            static void tessellate(
+                geom::TriangleMesh2& mesh, const draw::PointList& pts,
+                const float width, const bool soft = false,
+                const draw::Polyline2D::JointStyle jointStyle =
+                    draw::Polyline2D::JointStyle::MITER,
+                const draw::Polyline2D::EndCapStyle endStyle =
+                    draw::Polyline2D::EndCapStyle::BUTT,
+                const bool catmullRomSpline = false,
+                const bool allowOverlap = false);
+
+            //! Signature of the points, width and softness of a stroke, to
+            //! know when its mesh needs to be built again.
+            static uint64_t signature(
+                const draw::PointList& pts, const float width,
+                const bool soft);
+
+            //! Points of a circle.
+            static draw::PointList
+            circle(const math::Vector2f& center, const float radius);
+
             //! Draw a circle.
             void drawCircle(
                 const std::shared_ptr<timeline::IRender>& render,
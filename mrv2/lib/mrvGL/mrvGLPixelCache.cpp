@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "mrvGL/mrvGLErrors.h"
+#include "mrvGL/mrvGLPixelCache.h"
+
+namespace
+{
+    //! Size of the tile around the cursor, in pixels.
+    const int kTileSize = 64;
+
+    tl::math::Box2i
+    tileBox(const tl::math::Vector2i& pos, const tl::math::Size2i& renderSize)
+    {
+        tl::math::Box2i box;
+        box.min.x = std::max(0, pos.x - kTileSize / 2);
+        box.min.y = std::max(0, pos.y - kTileSize / 2);
+        box.max.x = std::min(renderSize.w - 1, box.min.x + kTileSize - 1);
+        box.max.y = std::min(renderSize.h - 1, box.min.y + kTileSize - 1);
+        return box;
+    }
+
+    bool contains(const tl::math::Box2i& box, const tl::math::Vector2i& pos)
+    {
+        return pos.x >= box.min.x && pos.x <= box.max.x &&
+               pos.y >= box.min.y && pos.y <= box.max.y;
+    }
+} // namespace
+
+namespace mrv
+{
+    namespace opengl
+    {
+        struct PixelCache::Private
+        {
+            Readback readback;
+
+            //! Whether a tile was requested and not mapped yet.
+            bool pending = false;
+
+            //! Tile in BGRA floats.
+            math::Box2i box;
+            std::vector<float> pixels;
+            bool valid = false;
+
+            PixelCacheStats stats;
+        };
+
+        PixelCache::PixelCache() :
+            _p(new Private)
+        {
+        }
+
+        PixelCache::~PixelCache() {}
+
+        void PixelCache::request(
+            const math::Vector2i& pos, const math::Size2i& renderSize)
+        {
+            TLRENDER_P();
+
+            p.valid = false;
+            if (!contains(math::Box2i(0, 0, renderSize.w, renderSize.h), pos))
+                return;
+
+            p.readback.read(tileBox(pos, renderSize));
+            p.pending = true;
+        }
+
+        void PixelCache::get(
+            image::Color4f& rgba, const math::Vector2i& pos,
+            const math::Size2i& renderSize, const bool latest)
+        {
+            TLRENDER_P();
+
+            if (p.pending)
+            {
+                math::Box2i box;
+                const float* data = p.readback.map(box, latest);
+                if (data)
+                {
+                    p.box = box;
+                    p.pixels.assign(
+                        data, data + static_cast<size_t>(box.w()) *
+                                         box.h() * 4);
+                    p.valid = true;
+                }
+                p.readback.unmap();
+                p.pending = false;
+            }
+
+            if (p.valid && contains(p.box, pos))
+            {
+                ++p.stats.hits;
+            }
+            else
+            {
+                p.box = tileBox(pos, renderSize);
+                p.pixels.resize(
+                    static_cast<size_t>(p.box.w()) * p.box.h() * 4);
+
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glPixelStorei(GL_PACK_SWAP_BYTES, GL_FALSE);
+                glReadPixels(
+                    p.box.min.x, p.box.min.y, p.box.w(), p.box.h(), GL_BGRA,
+                    GL_FLOAT, p.pixels.data());
+                CHECK_GL;
+                p.valid = true;
+
+                ++p.stats.misses;
+            }
+
+            const size_t offset = ((pos.x - p.box.min.x) +
+                                   (pos.y - p.box.min.y) * p.box.w()) *
+                                  4;
+            rgba.b = p.pixels[offset];
+            rgba.g = p.pixels[offset + 1];
+            rgba.r = p.pixels[offset + 2];
+            rgba.a = p.pixels[offset + 3];
+        }
+
+        void PixelCache::clear()
+        {
+            TLRENDER_P();
+            p.readback.clear();
+            p.pending = false;
+            p.valid = false;
+        }
+
+        const ReadbackStats& PixelCache::readbackStats() const noexcept
+        {
+            return _p->readback.stats();
+        }
+
+        const PixelCacheStats& PixelCache::stats() const noexcept
+        {
+            return _p->stats;
+        }
+
+    } // namespace opengl
+} // namespace mrv
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+#include <tlCore/Box.h>
+#include <tlCore/Color.h>
+#include <tlCore/Vector.h>
+
+#include "mrvGL/mrvGLReadback.h"
+
+namespace mrv
+{
+    namespace opengl
+    {
+        using namespace tl;
+
+        //! Statistics of a PixelCache.
+        struct PixelCacheStats
+        {
+            //! Pixels read from the cached tile.
+            uint64_t hits = 0;
+
+            //! Pixels that needed a synchronous read of a new tile.
+            uint64_t misses = 0;
+        };
+
+        /**
+         * CPU copy of a small tile of the render buffer around the
+         * cursor, so the pixel bar does not go to the GPU on every mouse
+         * move.  The tile is read asynchronously after each draw, through
+         * a Readback ring, and only read synchronously when the cursor
+         * leaves it.
+         */
+        class PixelCache
+        {
+        public:
+            PixelCache();
+            ~PixelCache();
+
+            /**
+             * Queue an asynchronous read of the tile around a pixel.  Call
+             * it with the render buffer bound after it changes, as it
+             * invalidates the tile.
+             */
+            void request(
+                const math::Vector2i& pos, const math::Size2i& renderSize);
+
+            /**
+             * Get a pixel from the tile, reading a new tile from the bound
+             * framebuffer if the pixel is not in it.
+             *
+             * @param latest Wait for the last tile requested instead of
+             *               using the last one that is done.
+             */
+            void get(
+                image::Color4f& rgba, const math::Vector2i& pos,
+                const math::Size2i& renderSize, const bool latest);
+
+            //! Release the GL resources.  Needs a current context.
+            void clear();
+
+            const ReadbackStats& readbackStats() const noexcept;
+            const PixelCacheStats& stats() const noexcept;
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+
+    } // namespace opengl
+} // namespace mrv
@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <vector>
+
+#include "mrvGL/mrvGLErrors.h"
+#include "mrvGL/mrvGLReadback.h"
+
+namespace
+{
+    //! Longest wait for a read, in nanoseconds.
+    const GLuint64 kWaitTimeout = 1000000000;
+
+    const unsigned kMinCount = 2;
+    const unsigned kMaxCount = 8;
+} // namespace
+
+namespace mrv
+{
+    namespace opengl
+    {
+        struct Readback::Private
+        {
+            struct Slot
+            {
+                GLuint id = 0;
+                GLsync fence = nullptr;
+                size_t capacity = 0;
+                math::Box2i box;
+                uint64_t frame = 0;
+
+                //! Whether the slot holds a read.
+                bool valid = false;
+
+                //! Whether the fence of the read has signalled.
+                bool done = false;
+            };
+
+            bool isDone(Slot& slot);
+            bool wait(Slot& slot);
+
+            std::vector<Slot> slots;
+            unsigned count = 3;
+
+            //! Count set by setCount(), applied on the next read.
+            unsigned newCount = 3;
+
+            //! Next slot to read into.
+            unsigned head = 0;
+
+            //! Slot currently mapped or -1.
+            int mapped = -1;
+
+            uint64_t frame = 0;
+            ReadbackStats stats;
+        };
+
+        bool Readback::Private::isDone(Slot& slot)
+        {
+            if (slot.done)
+                return true;
+            if (!slot.fence)
+                return false;
+
+            const GLenum result = glClientWaitSync(slot.fence, 0, 0);
+            if (result != GL_ALREADY_SIGNALED &&
+                result != GL_CONDITION_SATISFIED)
+                return false;
+
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            slot.done = true;
+            return true;
+        }
+
+        bool Readback::Private::wait(Slot& slot)
+        {
+            if (isDone(slot))
+                return true;
+            if (!slot.fence)
+                return false;
+
+            const GLenum result = glClientWaitSync(
+                slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, kWaitTimeout);
+            if (result != GL_ALREADY_SIGNALED &&
+                result != GL_CONDITION_SATISFIED)
+                return false;
+
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+            slot.done = true;
+            return true;
+        }
+
+        Readback::Readback() :
+            _p(new Private)
+        {
+        }
+
+        Readback::~Readback() {}
+
+        void Readback::setCount(const unsigned value)
+        {
+            TLRENDER_P();
+            p.newCount = std::clamp(value, kMinCount, kMaxCount);
+        }
+
+        unsigned Readback::count() const noexcept
+        {
+            return _p->newCount;
+        }
+
+        void Readback::read(const math::Box2i& box)
+        {
+            TLRENDER_P();
+
+            unmap();
+
+            if (p.newCount != p.count)
+            {
+                clear();
+                p.count = p.newCount;
+            }
+
+            if (p.slots.empty())
+            {
+                p.slots.resize(p.count);
+                for (auto& slot : p.slots)
+                    glGenBuffers(1, &slot.id);
+                p.head = 0;
+            }
+
+            auto& slot = p.slots[p.head];
+            p.head = (p.head + 1) % p.count;
+
+            // If the GPU is more than count reads behind, the oldest read
+            // is dropped.
+            if (slot.fence)
+            {
+                glDeleteSync(slot.fence);
+                slot.fence = nullptr;
+            }
+
+            const size_t dataSize =
+                static_cast<size_t>(box.w()) * box.h() * 4 * sizeof(GLfloat);
+
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glPixelStorei(GL_PACK_SWAP_BYTES, GL_FALSE);
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.id);
+            if (dataSize > slot.capacity)
+            {
+                glBufferData(
+                    GL_PIXEL_PACK_BUFFER, dataSize, 0, GL_STREAM_READ);
+                slot.capacity = dataSize;
+            }
+
+            // For faster access, we must use BGRA.
+            glReadPixels(
+                box.min.x, box.min.y, box.w(), box.h(), GL_BGRA, GL_FLOAT, 0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            CHECK_GL;
+
+            slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            slot.box = box;
+            slot.frame = ++p.frame;
+            slot.valid = true;
+            slot.done = false;
+
+            ++p.stats.reads;
+        }
+
+        const float* Readback::map(math::Box2i& box, const bool latest)
+        {
+            TLRENDER_P();
+
+            unmap();
+
+            if (p.slots.empty())
+                return nullptr;
+
+            int index = -1;
+            if (latest)
+            {
+                const unsigned last = (p.head + p.count - 1) % p.count;
+                if (p.slots[last].valid && p.wait(p.slots[last]))
+                    index = last;
+            }
+            else
+            {
+                // Most recent read that is done.
+                for (unsigned i = 1; i <= p.count; ++i)
+                {
+                    const unsigned slot = (p.head + p.count - i) % p.count;
+                    if (p.slots[slot].valid && p.isDone(p.slots[slot]))
+                    {
+                        index = slot;
+                        break;
+                    }
+                }
+
+                // None is, so wait for the oldest read.
+                if (index < 0)
+                {
+                    for (unsigned i = 0; i < p.count; ++i)
+                    {
+                        const unsigned slot = (p.head + i) % p.count;
+                        if (!p.slots[slot].valid)
+                            continue;
+                        ++p.stats.stalls;
+                        if (p.wait(p.slots[slot]))
+                            index = slot;
+                        break;
+                    }
+                }
+            }
+
+            if (index < 0)
+                return nullptr;
+
+            auto& slot = p.slots[index];
+            const size_t dataSize = static_cast<size_t>(slot.box.w()) *
+                                    slot.box.h() * 4 * sizeof(GLfloat);
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.id);
+            void* data = glMapBufferRange(
+                GL_PIXEL_PACK_BUFFER, 0, dataSize, GL_MAP_READ_BIT);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            if (!data)
+                return nullptr;
+
+            p.mapped = index;
+            p.stats.latency = static_cast<unsigned>(p.frame - slot.frame);
+            box = slot.box;
+            return static_cast<const float*>(data);
+        }
+
+        void Readback::unmap()
+        {
+            TLRENDER_P();
+            if (p.mapped < 0)
+                return;
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, p.slots[p.mapped].id);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            p.mapped = -1;
+        }
+
+        void Readback::clear()
+        {
+            TLRENDER_P();
+
+            unmap();
+
+            for (auto& slot : p.slots)
+            {
+                if (slot.fence)
+                    glDeleteSync(slot.fence);
+                glDeleteBuffers(1, &slot.id);
+            }
+            p.slots.clear();
+            p.head = 0;
+        }
+
+        const ReadbackStats& Readback::stats() const noexcept
+        {
+            return _p->stats;
+        }
+
+    } // namespace opengl
+} // namespace mrv
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+
+#include <tlCore/Util.h>
+#include <tlCore/Box.h>
+
+namespace mrv
+{
+    namespace opengl
+    {
+        using namespace tl;
+
+        //! Statistics of a Readback ring.
+        struct ReadbackStats
+        {
+            //! Number of frames between the last read mapped and the
+            //! last read issued.
+            unsigned latency = 0;
+
+            //! Number of reads issued.
+            uint64_t reads = 0;
+
+            //! Number of maps that had to wait for the GPU.
+            uint64_t stalls = 0;
+        };
+
+        /**
+         * Asynchronous readback of a region of the bound framebuffer as
+         * BGRA floats.  Reads go into a ring of pixel pack buffers, each
+         * guarded by a fence, and only buffers whose fence has signalled
+         * are mapped, so the CPU does not wait for the GPU while playing.
+         */
+        class Readback
+        {
+        public:
+            Readback();
+            ~Readback();
+
+            //! Number of buffers of the ring (2 to 8).  The buffers are
+            //! released on the next read, so it needs no current context.
+            void setCount(const unsigned value);
+            unsigned count() const noexcept;
+
+            //! Queue a read of a region of the bound read framebuffer.
+            void read(const math::Box2i& box);
+
+            /**
+             * Map the most recent read that is done.
+             *
+             * @param box    Returns the region of the mapped pixels.
+             * @param latest Map the last read issued, waiting for it if
+             *               needed (used when playback is stopped).
+             *
+             * @return the tightly packed pixels or nullptr.
+             */
+            const float* map(math::Box2i& box, const bool latest);
+
+            //! Unmap the mapped buffer, if any.
+            void unmap();
+
+            //! Release the buffers and fences.  Needs a current context.
+            void clear();
+
+            const ReadbackStats& stats() const noexcept;
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+
+    } // namespace opengl
+} // namespace mrv
@@ -29,11 +29,9 @@ namespace mrv
             GL_ONE_MINUS_SRC_ALPHA);
         CHECK_GL;
 
-        const bool catmullRomSpline = true;
-        CHECK_GL;
-        lines->drawLines(
-            render, pts, color, pen_size, soft, Polyline2D::JointStyle::ROUND,
-            Polyline2D::EndCapStyle::ROUND, catmullRomSpline);
+        lines->drawStroke(
+            render, id, pts, color, pen_size, soft,
+            Polyline2D::JointStyle::ROUND, Polyline2D::EndCapStyle::ROUND);
         CHECK_GL;
     }
 
@@ -50,10 +48,9 @@ namespace mrv
         color.r = color.g = color.b = 0.F;
         color.a = 1.F;
 
-        const bool catmullRomSpline = false;
-        lines->drawLines(
-            render, pts, color, pen_size, soft, Polyline2D::JointStyle::ROUND,
-            Polyline2D::EndCapStyle::ROUND, catmullRomSpline);
+        lines->drawStroke(
+            render, id, pts, color, pen_size, soft,
+            Polyline2D::JointStyle::ROUND, Polyline2D::EndCapStyle::ROUND);
     }
 
     void GLCircleShape::draw(
@@ -66,7 +63,19 @@ namespace mrv
             GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
             GL_ONE_MINUS_SRC_ALPHA);
 
-        lines->drawCircle(render, center, radius, pen_size, color, soft);
+        // The center and the radius are the signature of the circle.
+        const draw::PointList signature = {
+            draw::Point(center), draw::Point(radius, 0.0)};
+        lines->drawMesh(
+            render, id, opengl::Lines::signature(signature, pen_size, soft),
+            [this](geom::TriangleMesh2& mesh)
+            {
+                opengl::Lines::tessellate(
+                    mesh, opengl::Lines::circle(center, radius), pen_size,
+                    soft, draw::Polyline2D::JointStyle::ROUND,
+                    draw::Polyline2D::EndCapStyle::JOINT);
+            },
+            color, soft);
     }
 
     void GLRectangleShape::draw(
@@ -82,9 +91,15 @@ namespace mrv
             GL_ONE_MINUS_SRC_ALPHA);
 
         const bool catmullRomSpline = false;
-        lines->drawLines(
-            render, pts, color, pen_size, soft, Polyline2D::JointStyle::ROUND,
-            Polyline2D::EndCapStyle::JOINT, catmullRomSpline);
+        lines->drawMesh(
+            render, id, opengl::Lines::signature(pts, pen_size, soft),
+            [this](geom::TriangleMesh2& mesh)
+            {
+                opengl::Lines::tessellate(
+                    mesh, pts, pen_size, soft, Polyline2D::JointStyle::ROUND,
+                    Polyline2D::EndCapStyle::JOINT, catmullRomSpline);
+            },
+            color, soft);
     }
 
     void GLArrowShape::draw(
@@ -115,26 +130,25 @@ namespace mrv
             Polyline2D::EndCapStyle::BUTT, catmullRomSpline, allowOverlap);
 
 #else
-        line.push_back(pts[1]);
-        line.push_back(pts[2]);
-        lines->drawLines(
-            render, line, color, pen_size, soft, Polyline2D::JointStyle::ROUND,
-            Polyline2D::EndCapStyle::ROUND, catmullRomSpline);
-
-        line.clear();
-        line.push_back(pts[1]);
-        line.push_back(pts[4]);
-
-        lines->drawLines(
-            render, line, color, pen_size, soft, Polyline2D::JointStyle::ROUND,
-            Polyline2D::EndCapStyle::ROUND, catmullRomSpline);
-
-        line.clear();
-        line.push_back(pts[0]);
-        line.push_back(pts[1]);
-        lines->drawLines(
-            render, line, color, pen_size, soft, Polyline2D::JointStyle::ROUND,
-            Polyline2D::EndCapStyle::ROUND, catmullRomSpline);
+        // The two sides of the head and the body of the arrow are drawn
+        // as a single mesh.
+        lines->drawMesh(
+            render, id, opengl::Lines::signature(pts, pen_size, soft),
+            [&](geom::TriangleMesh2& mesh)
+            {
+                const int segments[3][2] = {{1, 2}, {1, 4}, {0, 1}};
+                for (const auto& segment : segments)
+                {
+                    line.clear();
+                    line.push_back(pts[segment[0]]);
+                    line.push_back(pts[segment[1]]);
+                    opengl::Lines::tessellate(
+                        mesh, line, pen_size, soft,
+                        Polyline2D::JointStyle::ROUND,
+                        Polyline2D::EndCapStyle::ROUND, catmullRomSpline);
+                }
+            },
+            color, soft);
 #endif
     }
 
@@ -2,6 +2,7 @@
 // mrv2
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
+#include <algorithm>
 #include <cinttypes>
 
 #include <tlCore/FontSystem.h>
@@ -16,6 +17,7 @@
 #include "mrViewer.h"
 #include "mrvHotkeyUI.h"
 
+#include "mrvCore/mrvScopes.h"
 #include "mrvCore/mrvColorSpaces.h"
 #include "mrvCore/mrvLocale.h"
 #include "mrvCore/mrvSequence.h"
@@ -75,13 +77,23 @@ namespace mrv
         _gl->context = context;
     }
 
+    void Viewport::setReadbackBuffers(const unsigned value)
+    {
+        MRV2_GL();
+        gl.readbackCount = value;
+        if (gl.readback)
+            gl.readback->setCount(value);
+    }
+
     //! Refresh window by clearing the associated resources.
     void Viewport::refresh()
     {
         TLRENDER_P();
         MRV2_GL();
-        if (gl.render)
-            glDeleteBuffers(2, gl.pboIds);
+        if (gl.readback)
+            gl.readback->clear();
+        if (gl.pixelCache)
+            gl.pixelCache->clear();
         gl.render.reset();
         gl.outline.reset();
         gl.lines.reset();
@@ -96,8 +108,6 @@ namespace mrv
         gl.vbo.reset();
         gl.vao.reset();
         p.fontSystem.reset();
-        gl.index = 0;
-        gl.nextIndex = 1;
     }
 
     void Viewport::_initializeGLResources()
@@ -110,7 +120,9 @@ namespace mrv
 
             gl.render = timeline_gl::Render::create(context);
 
-            glGenBuffers(2, gl.pboIds);
+            gl.readback = std::make_shared<opengl::Readback>();
+            gl.readback->setCount(gl.readbackCount);
+            gl.pixelCache = std::make_shared<opengl::PixelCache>();
 
             p.fontSystem = image::FontSystem::create(context);
 
@@ -283,15 +295,6 @@ namespace mrv
                 {
                     gl.buffer = gl::OffscreenBuffer::create(
                         renderSize, offscreenBufferOptions);
-                    unsigned dataSize =
-                        renderSize.w * renderSize.h * 4 * sizeof(GLfloat);
-                    glBindBuffer(GL_PIXEL_PACK_BUFFER, gl.pboIds[0]);
-                    glBufferData(
-                        GL_PIXEL_PACK_BUFFER, dataSize, 0, GL_STREAM_READ);
-                    glBindBuffer(GL_PIXEL_PACK_BUFFER, gl.pboIds[1]);
-                    glBufferData(
-                        GL_PIXEL_PACK_BUFFER, dataSize, 0, GL_STREAM_READ);
-                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
                 }
 
                 if (can_do(FL_STEREO))
@@ -543,6 +546,18 @@ namespace mrv
                 }
             }
 
+            // Read the tile around the cursor for the pixel bar while the
+            // frame is still in the offscreen buffer.  It is mapped on the
+            // next pixel bar update, usually without waiting for the GPU.
+            if (gl.pixelCache && p.ui->uiPixelBar->visible() &&
+                p.ui->uiPixelWindow->uiPixelValue->value() ==
+                    PixelValue::kFull &&
+                !_isEnvironmentMap())
+            {
+                gl::OffscreenBufferBinding binding(gl.buffer);
+                gl.pixelCache->request(_getRaster(), renderSize);
+            }
+
             math::Box2i selection = p.colorAreaInfo.box = p.selection;
             if (selection.max.x >= 0)
             {
@@ -563,22 +578,30 @@ namespace mrv
                 p.colorAreaInfo.box = selection;
 
                 if (panel::colorAreaPanel || panel::histogramPanel ||
-                    panel::vectorscopePanel)
+                    panel::vectorscopePanel || panel::waveformPanel)
                 {
-                    _mapBuffer();
+                    _mapBuffer(selection);
+
+                    _calculateScopes();
 
                     if (panel::colorAreaPanel)
                     {
-                        _calculateColorArea(p.colorAreaInfo);
                         panel::colorAreaPanel->update(p.colorAreaInfo);
                     }
                     if (panel::histogramPanel)
                     {
-                        panel::histogramPanel->update(p.colorAreaInfo);
+                        panel::histogramPanel->update(p.histogram);
                     }
                     if (panel::vectorscopePanel)
                     {
-                        panel::vectorscopePanel->update(p.colorAreaInfo);
+                        panel::vectorscopePanel->update(p.vectorscope);
+                    }
+                    if (panel::waveformPanel && p.image)
+                    {
+                        const math::Box2i& area = p.imageBox;
+                        panel::waveformPanel->update(
+                            math::Box2i(0, 0, area.w(), area.h()), p.image,
+                            math::Size2i(area.w(), area.h()));
                     }
                 }
                 else
@@ -646,6 +669,10 @@ namespace mrv
                 _drawAnnotations(mvp, player->currentTime(), annotations);
             }
 
+            // Release the meshes of shapes no longer shown, even when no
+            // annotations are, so hiding them frees the GPU memory.
+            gl.lines->collect();
+
             if (p.dataWindow)
                 _drawDataWindow();
             if (p.displayWindow)
@@ -716,206 +743,86 @@ namespace mrv
 #endif
     }
 
-    void Viewport::_calculateColorAreaFullValues(area::Info& info) noexcept
-    {
-        TLRENDER_P();
-        MRV2_GL();
-
-        PixelToolBarClass* c = p.ui->uiPixelWindow;
-        BrightnessType brightness_type = (BrightnessType)c->uiLType->value();
-        int hsv_colorspace = c->uiBColorType->value() + 1;
-
-        const int maxX = info.box.max.x;
-        const int maxY = info.box.max.y;
-        const auto& renderSize = gl.buffer->getSize();
-
-        for (int Y = info.box.y(); Y <= maxY; ++Y)
-        {
-            for (int X = info.box.x(); X <= maxX; ++X)
-            {
-                image::Color4f rgba, hsv;
-                rgba.b = p.image[(X + Y * renderSize.w) * 4];
-                rgba.g = p.image[(X + Y * renderSize.w) * 4 + 1];
-                rgba.r = p.image[(X + Y * renderSize.w) * 4 + 2];
-                rgba.a = p.image[(X + Y * renderSize.w) * 4 + 3];
-
-                info.rgba.mean.r += rgba.r;
-                info.rgba.mean.g += rgba.g;
-                info.rgba.mean.b += rgba.b;
-                info.rgba.mean.a += rgba.a;
-
-                if (rgba.r < info.rgba.min.r)
-                    info.rgba.min.r = rgba.r;
-                if (rgba.g < info.rgba.min.g)
-                    info.rgba.min.g = rgba.g;
-                if (rgba.b < info.rgba.min.b)
-                    info.rgba.min.b = rgba.b;
-                if (rgba.a < info.rgba.min.a)
-                    info.rgba.min.a = rgba.a;
-
-                if (rgba.r > info.rgba.max.r)
-                    info.rgba.max.r = rgba.r;
-                if (rgba.g > info.rgba.max.g)
-                    info.rgba.max.g = rgba.g;
-                if (rgba.b > info.rgba.max.b)
-                    info.rgba.max.b = rgba.b;
-                if (rgba.a > info.rgba.max.a)
-                    info.rgba.max.a = rgba.a;
-
-                hsv = rgba_to_hsv(hsv_colorspace, rgba);
-                hsv.a = calculate_brightness(rgba, brightness_type);
-                hsv_to_info(hsv, info);
-            }
-        }
-
-        int num = info.box.w() * info.box.h();
-        info.rgba.mean.r /= num;
-        info.rgba.mean.g /= num;
-        info.rgba.mean.b /= num;
-        info.rgba.mean.a /= num;
-
-        info.rgba.diff.r = info.rgba.max.r - info.rgba.min.r;
-        info.rgba.diff.g = info.rgba.max.g - info.rgba.min.g;
-        info.rgba.diff.b = info.rgba.max.b - info.rgba.min.b;
-        info.rgba.diff.a = info.rgba.max.a - info.rgba.min.a;
-
-        info.hsv.mean.r /= num;
-        info.hsv.mean.g /= num;
-        info.hsv.mean.b /= num;
-        info.hsv.mean.a /= num;
-
-        info.hsv.diff.r = info.hsv.max.r - info.hsv.min.r;
-        info.hsv.diff.g = info.hsv.max.g - info.hsv.min.g;
-        info.hsv.diff.b = info.hsv.max.b - info.hsv.min.b;
-        info.hsv.diff.a = info.hsv.max.a - info.hsv.min.a;
-    }
-
-    void Viewport::_calculateColorArea(area::Info& info)
+    void Viewport::_calculateScopes()
     {
         TLRENDER_P();
-        MRV2_GL();
 
-        if (!p.image || !gl.buffer)
+        if (!p.image)
             return;
 
-        info.rgba.max.r = std::numeric_limits<float>::min();
-        info.rgba.max.g = std::numeric_limits<float>::min();
-        info.rgba.max.b = std::numeric_limits<float>::min();
-        info.rgba.max.a = std::numeric_limits<float>::min();
-
-        info.rgba.min.r = std::numeric_limits<float>::max();
-        info.rgba.min.g = std::numeric_limits<float>::max();
-        info.rgba.min.b = std::numeric_limits<float>::max();
-        info.rgba.min.a = std::numeric_limits<float>::max();
-
-        info.rgba.mean.r = info.rgba.mean.g = info.rgba.mean.b =
-            info.rgba.mean.a = 0.F;
-
-        info.hsv.max.r = std::numeric_limits<float>::min();
-        info.hsv.max.g = std::numeric_limits<float>::min();
-        info.hsv.max.b = std::numeric_limits<float>::min();
-        info.hsv.max.a = std::numeric_limits<float>::min();
-
-        info.hsv.min.r = std::numeric_limits<float>::max();
-        info.hsv.min.g = std::numeric_limits<float>::max();
-        info.hsv.min.b = std::numeric_limits<float>::max();
-        info.hsv.min.a = std::numeric_limits<float>::max();
-
-        info.hsv.mean.r = info.hsv.mean.g = info.hsv.mean.b = info.hsv.mean.a =
-            0.F;
-
-        if (p.ui->uiPixelWindow->uiPixelValue->value() == PixelValue::kFull)
-            _calculateColorAreaFullValues(info);
-        else
-            _calculateColorAreaRawValues(info);
+        PixelToolBarClass* c = p.ui->uiPixelWindow;
+        scopes::Options options;
+        options.brightnessType = (BrightnessType)c->uiLType->value();
+        options.hsvColorspace = c->uiBColorType->value() + 1;
+
+        // Both full and raw values are in the mapped BGRA buffer, so all
+        // the scopes are calculated in a single pass over it.  The buffer
+        // holds just the selection, which may be a frame or two old while
+        // playing.
+        const math::Box2i& area = p.imageBox;
+        scopes::process(
+            panel::colorAreaPanel ? &p.colorAreaInfo : nullptr,
+            panel::histogramPanel ? &p.histogram : nullptr,
+            panel::vectorscopePanel ? &p.vectorscope : nullptr,
+            math::Box2i(0, 0, area.w(), area.h()), p.image,
+            math::Size2i(area.w(), area.h()), options);
     }
 
-    void Viewport::_mapBuffer() const noexcept
+    void Viewport::_mapBuffer(const math::Box2i& box) const noexcept
     {
         MRV2_GL();
         TLRENDER_P();
 
         if (p.ui->uiPixelWindow->uiPixelValue->value() == PixelValue::kFull)
         {
-
-            // For faster access, we muse use BGRA.
-            constexpr GLenum format = GL_BGRA;
-            constexpr GLenum type = GL_FLOAT;
-
-            glPixelStorei(GL_PACK_ALIGNMENT, 1);
-            glPixelStorei(GL_PACK_SWAP_BYTES, GL_FALSE);
-
-            gl::OffscreenBufferBinding binding(gl.buffer);
-            const auto& renderSize = gl.buffer->getSize();
-
-            // bool update = _shouldUpdatePixelBar();
-            bool stopped = _isPlaybackStopped();
-            bool single_frame = _isSingleFrame();
-
-            // set the target framebuffer to read
-            // "index" is used to read pixels from framebuffer to a PBO
-            // "nextIndex" is used to update pixels in the other PBO
-            gl.index = (gl.index + 1) % 2;
-            gl.nextIndex = (gl.index + 1) % 2;
-
-            // If we are a single frame, we do a normal ReadPixels of front
-            // buffer.
-
-            if (single_frame)
+            _unmapBuffer();
+            if (p.rawImage)
             {
-                _unmapBuffer();
-                _mallocBuffer();
-                if (!p.image)
-                    return;
-                glBindFramebuffer(GL_FRAMEBUFFER, 0);
-                glReadBuffer(GL_FRONT);
-                glReadPixels(
-                    0, 0, renderSize.w, renderSize.h, format, type, p.image);
-                return;
+                free(p.image);
+                p.image = nullptr;
             }
-            else
-            {
-
-                // read pixels from framebuffer to PBO
-                // glReadPixels() should return immediately.
-                glBindBuffer(GL_PIXEL_PACK_BUFFER, gl.pboIds[gl.index]);
 
-                glReadPixels(0, 0, renderSize.w, renderSize.h, format, type, 0);
-
-                // map the PBO to process its data by CPU
-                glBindBuffer(GL_PIXEL_PACK_BUFFER, gl.pboIds[gl.nextIndex]);
+            if (!gl.buffer || !gl.readback)
+                return;
 
-                // We are stopped, read the first PBO.
-                if (stopped)
-                {
-                    glBindBuffer(GL_PIXEL_PACK_BUFFER, gl.pboIds[gl.index]);
-                }
-            }
+            // Read back just the selection.
+            const auto& renderSize = gl.buffer->getSize();
+            math::Box2i area;
+            area.min.x = std::max(box.min.x, 0);
+            area.min.y = std::max(box.min.y, 0);
+            area.max.x = std::min(box.max.x, renderSize.w - 1);
+            area.max.y = std::min(box.max.y, renderSize.h - 1);
+            if (area.max.x < area.min.x || area.max.y < area.min.y)
+                return;
 
-            if (p.rawImage)
             {
-                free(p.image);
-                p.image = nullptr;
+                gl::OffscreenBufferBinding binding(gl.buffer);
+                gl.readback->read(area);
             }
 
-            p.image = (float*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            // If we are stopped or a single frame, we wait for the pixels
+            // of this frame.  While playing, we map the last read that is
+            // done, which is usually a frame or two old.
+            const bool latest = _isPlaybackStopped() || _isSingleFrame();
+            p.image = (float*)gl.readback->map(p.imageBox, latest);
             p.rawImage = false;
         }
         else
         {
-            TimelineViewport::_mapBuffer();
+            TimelineViewport::_mapBuffer(box);
         }
     }
 
     void Viewport::_unmapBuffer() const noexcept
     {
         TLRENDER_P();
+        MRV2_GL();
 
         if (p.image)
         {
             if (!p.rawImage)
             {
-                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                gl.readback->unmap();
                 p.image = nullptr;
                 p.rawImage = true;
             }
@@ -997,37 +904,39 @@ namespace mrv
 
             const GLenum type = GL_FLOAT;
 
-            if (update)
+            if (_isEnvironmentMap())
             {
                 _unmapBuffer();
-                if (_isEnvironmentMap())
-                {
-                    pos = _getFocus();
-                    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-                    glReadBuffer(GL_FRONT);
-                    glReadPixels(pos.x, pos.y, 1, 1, GL_RGBA, type, &rgba);
-                    return;
-                }
-                else
-                {
-                    Viewport* self = const_cast<Viewport*>(this);
-                    self->make_current();
-                    gl::OffscreenBufferBinding binding(gl.buffer);
-                    glReadPixels(pos.x, pos.y, 1, 1, GL_RGBA, type, &rgba);
-                    return;
-                }
+                pos = _getFocus();
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+                glReadBuffer(GL_FRONT);
+                glReadPixels(pos.x, pos.y, 1, 1, GL_RGBA, type, &rgba);
+                return;
             }
 
-            if (!p.image)
-                _mapBuffer();
-
-            if (p.image)
+            const math::Box2i& area = p.imageBox;
+            if (!update && p.image && !p.rawImage && pos.x >= area.min.x &&
+                pos.x <= area.max.x && pos.y >= area.min.y &&
+                pos.y <= area.max.y)
             {
-                const auto& renderSize = gl.buffer->getSize();
-                rgba.b = p.image[(pos.x + pos.y * renderSize.w) * 4];
-                rgba.g = p.image[(pos.x + pos.y * renderSize.w) * 4 + 1];
-                rgba.r = p.image[(pos.x + pos.y * renderSize.w) * 4 + 2];
-                rgba.a = p.image[(pos.x + pos.y * renderSize.w) * 4 + 3];
+                const size_t offset =
+                    ((pos.x - area.min.x) + (pos.y - area.min.y) * area.w()) *
+                    4;
+                rgba.b = p.image[offset];
+                rgba.g = p.image[offset + 1];
+                rgba.r = p.image[offset + 2];
+                rgba.a = p.image[offset + 3];
+            }
+            else
+            {
+                // The pixel is read from the tile cached around the cursor.
+                // When stopped, we wait for the tile of this frame.
+                _unmapBuffer();
+                Viewport* self = const_cast<Viewport*>(this);
+                self->make_current();
+                gl::OffscreenBufferBinding binding(gl.buffer);
+                gl.pixelCache->get(rgba, pos, getRenderSize(), update);
+                return;
             }
         }
 
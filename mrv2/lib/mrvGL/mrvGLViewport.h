@@ -34,6 +34,10 @@ namespace mrv
         //! Set the internal system context for the widget.
         void setContext(const std::weak_ptr<system::Context>& context);
 
+        //! Set the number of buffers used to read back the selection for
+        //! the scopes.
+        void setReadbackBuffers(const unsigned value);
+
         //! Refresh window by clearing the associated resources.
         void refresh() override;
 
@@ -49,7 +53,9 @@ namespace mrv
 
         math::Matrix4x4f _createTexturedRectangle();
 
-        void _calculateColorArea(mrv::area::Info& info);
+        //! Calculate the color area, histogram and vectorscope of the
+        //! selection for the panels that are open.
+        void _calculateScopes();
 
         void _drawAnaglyph(int, int) const noexcept;
 
@@ -104,15 +110,14 @@ namespace mrv
             const float pixelAspectRatio, const image::Color4f& color,
             const math::Matrix4x4f& mvp, const char* label = "") const noexcept;
 
-        void _mapBuffer() const noexcept;
+        //! Read back a region of the render buffer into the image.
+        void _mapBuffer(const math::Box2i& box) const noexcept;
         void _unmapBuffer() const noexcept;
 
         void _drawShape(
             const std::shared_ptr< draw::Shape >& shape,
             const float alphamult = 1.F) noexcept;
 
-        void _calculateColorAreaFullValues(area::Info& info) noexcept;
-
         void _drawWindowArea(const std::string&) const noexcept;
 
     private:
@@ -1050,6 +1050,30 @@ namespace mrv
                 labelColor);
         }
 
+        if ((p.hud & HudDisplay::kReadback) && gl.readback)
+        {
+            const auto& stats = gl.readback->stats();
+            uint64_t reads = stats.reads;
+            uint64_t stalls = stats.stalls;
+            uint64_t hits = 0, misses = 0;
+            if (gl.pixelCache)
+            {
+                reads += gl.pixelCache->readbackStats().reads;
+                stalls += gl.pixelCache->readbackStats().stalls;
+                hits = gl.pixelCache->stats().hits;
+                misses = gl.pixelCache->stats().misses;
+            }
+            snprintf(
+                buf, 512,
+                _("Readback: %u buffers  Latency: %u  Stalls: %" PRIu64
+                  " of %" PRIu64 "  Pixel Hits: %" PRIu64 " of %" PRIu64),
+                gl.readback->count(), stats.latency, stalls, reads, hits,
+                hits + misses);
+            _drawText(
+                p.fontSystem->getGlyphs(buf, fontInfo), pos, lineHeight,
+                labelColor);
+        }
+
         if (p.hud & HudDisplay::kAttributes)
         {
             for (const auto& tag : p.tagData)
@@ -16,6 +16,8 @@
 #include "mrvGL/mrvGLLines.h"
 #include "mrvGL/mrvGLViewport.h"
 #include "mrvGL/mrvGLOutline.h"
+#include "mrvGL/mrvGLPixelCache.h"
+#include "mrvGL/mrvGLReadback.h"
 
 namespace mrv
 {
@@ -33,9 +35,14 @@ namespace mrv
         std::shared_ptr<gl::Shader> shader;
         std::shared_ptr<gl::Shader> annotationShader;
         std::shared_ptr<gl::Shader> stereoShader;
-        int index = 0;
-        int nextIndex = 1;
-        GLuint pboIds[2];
+
+        //! Ring of pixel pack buffers to read back the selection.
+        std::shared_ptr<opengl::Readback> readback;
+        unsigned readbackCount = 3;
+
+        //! Tile around the cursor read back for the pixel bar.
+        std::shared_ptr<opengl::PixelCache> pixelCache;
+
         std::shared_ptr<gl::VBO> vbo;
         std::shared_ptr<gl::VAO> vao;
 
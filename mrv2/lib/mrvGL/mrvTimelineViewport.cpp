@@ -29,6 +29,8 @@
 #include "mrvCore/mrvMath.h"
 #include "mrvCore/mrvHotkey.h"
 #include "mrvCore/mrvColorSpaces.h"
+#include "mrvCore/mrvPixelDecode.h"
+#include "mrvCore/mrvThreadPool.h"
 
 #include "mrvWidgets/mrvHorSlider.h"
 #include "mrvWidgets/mrvMultilineInput.h"
@@ -2381,64 +2383,7 @@ namespace mrv
     image::Color4f TimelineViewport::rgba_to_hsv(
         int hsv_colorspace, image::Color4f& rgba) const noexcept
     {
-        if (rgba.r < 0.F)
-            rgba.r = 0.F;
-        else if (rgba.r > 1.F)
-            rgba.r = 1.F;
-        if (rgba.g < 0.F)
-            rgba.g = 0.F;
-        else if (rgba.g > 1.F)
-            rgba.g = 1.F;
-        if (rgba.b < 0.F)
-            rgba.b = 0.F;
-        else if (rgba.b > 1.F)
-            rgba.b = 1.F;
-
-        image::Color4f hsv;
-
-        switch (hsv_colorspace)
-        {
-        case color::kHSV:
-            hsv = color::rgb::to_hsv(rgba);
-            break;
-        case color::kHSL:
-            hsv = color::rgb::to_hsl(rgba);
-            break;
-#ifdef TLRENDER_HSV
-        case color::kCIE_XYZ:
-            hsv = color::rgb::to_xyz(rgba);
-            break;
-        case color::kCIE_xyY:
-            hsv = color::rgb::to_xyY(rgba);
-            break;
-        case color::kCIE_Lab:
-            hsv = color::rgb::to_lab(rgba);
-            break;
-        case color::kCIE_Luv:
-            hsv = color::rgb::to_luv(rgba);
-            break;
-#endif
-        case color::kYUV:
-            hsv = color::rgb::to_yuv(rgba);
-            break;
-        case color::kYDbDr:
-            hsv = color::rgb::to_YDbDr(rgba);
-            break;
-        case color::kYIQ:
-            hsv = color::rgb::to_yiq(rgba);
-            break;
-        case color::kITU_601:
-            hsv = color::rgb::to_ITU601(rgba);
-            break;
-        case color::kITU_709:
-            hsv = color::rgb::to_ITU709(rgba);
-            break;
-        case color::kRGB:
-        default:
-            hsv = rgba;
-            break;
-        }
-        return hsv;
+        return color::rgba_to_space(hsv_colorspace, rgba);
     }
 
     void TimelineViewport::_getPixelValue(
@@ -2446,396 +2391,13 @@ namespace mrv
         const math::Vector2i& pos) const noexcept
     {
         TLRENDER_P();
-        image::PixelType type = image->getPixelType();
-        uint8_t channels = image::getChannelCount(type);
-        uint8_t depth = image::getBitDepth(type) / 8;
-        const auto& info = image->getInfo();
-        auto pixelAspectRatio = info.size.pixelAspectRatio;
-        image::VideoLevels videoLevels = info.videoLevels;
-        const math::Vector4f& yuvCoefficients =
-            getYUVCoefficients(info.yuvCoefficients);
-        auto size = image->getSize();
-        const uint8_t* data = image->getData();
-        int X = pos.x / pixelAspectRatio;
-        int Y = size.h - pos.y - 1;
-        if (p.displayOptions[0].mirror.x)
-            X = size.w - X - 1;
-        if (p.displayOptions[0].mirror.y)
-            Y = size.h - Y - 1;
-
-        // Do some sanity check just in case
-        if (X < 0 || Y < 0 || X >= size.w || Y >= size.h)
+        const auto& mirror = p.displayOptions[0].mirror;
+        const pixel::RowDecoder decoder(image, mirror.x, mirror.y);
+        if (!decoder.isValid())
             return;
 
-        size_t offset = (Y * size.w + X);
-
-        switch (type)
-        {
-        case image::PixelType::YUV_420P_U8:
-        case image::PixelType::YUV_422P_U8:
-        case image::PixelType::YUV_444P_U8:
-            break;
-        case image::PixelType::YUV_420P_U16:
-        case image::PixelType::YUV_422P_U16:
-        case image::PixelType::YUV_444P_U16:
-            break;
-        default:
-            offset *= channels * depth;
-            break;
-        }
-
-        rgba.a = 1.0f;
-        switch (type)
-        {
-        case image::PixelType::L_U8:
-            rgba.r = data[offset] / 255.0f;
-            rgba.g = data[offset] / 255.0f;
-            rgba.b = data[offset] / 255.0f;
-            break;
-        case image::PixelType::LA_U8:
-            rgba.r = data[offset] / 255.0f;
-            rgba.g = data[offset] / 255.0f;
-            rgba.b = data[offset] / 255.0f;
-            rgba.a = data[offset + 1] / 255.0f;
-            break;
-        case image::PixelType::L_U16:
-        {
-            uint16_t* f = (uint16_t*)(&data[offset]);
-            rgba.r = f[0] / 65535.0f;
-            rgba.g = f[0] / 65535.0f;
-            rgba.b = f[0] / 65535.0f;
-            break;
-        }
-        case image::PixelType::LA_U16:
-        {
-            uint16_t* f = (uint16_t*)(&data[offset]);
-            rgba.r = f[0] / 65535.0f;
-            rgba.g = f[0] / 65535.0f;
-            rgba.b = f[0] / 65535.0f;
-            rgba.a = f[1] / 65535.0f;
-            break;
-        }
-        case image::PixelType::L_U32:
-        {
-            uint32_t* f = (uint32_t*)(&data[offset]);
-            constexpr float max =
-                static_cast<float>(std::numeric_limits<uint32_t>::max());
-            rgba.r = f[0] / max;
-            rgba.g = f[0] / max;
-            rgba.b = f[0] / max;
-            break;
-        }
-        case image::PixelType::LA_U32:
-        {
-            uint32_t* f = (uint32_t*)(&data[offset]);
-            constexpr float max =
-                static_cast<float>(std::numeric_limits<uint32_t>::max());
-            rgba.r = f[0] / max;
-            rgba.g = f[0] / max;
-            rgba.b = f[0] / max;
-            rgba.a = f[1] / max;
-            break;
-        }
-        case image::PixelType::L_F16:
-        {
-            half* f = (half*)(&data[offset]);
-            rgba.r = f[0];
-            rgba.g = f[0];
-            rgba.b = f[0];
-            break;
-        }
-        case image::PixelType::LA_F16:
-        {
-            half* f = (half*)(&data[offset]);
-            rgba.r = f[0];
-            rgba.g = f[0];
-            rgba.b = f[0];
-            rgba.a = f[1];
-            break;
-        }
-        case image::PixelType::RGB_U8:
-            rgba.r = data[offset] / 255.0f;
-            rgba.g = data[offset + 1] / 255.0f;
-            rgba.b = data[offset + 2] / 255.0f;
-            break;
-        case image::PixelType::RGB_U10:
-        {
-            image::U10* f = (image::U10*)(&data[offset]);
-            constexpr float max =
-                static_cast<float>(std::numeric_limits<uint32_t>::max());
-            rgba.r = f->r / max;
-            rgba.g = f->g / max;
-            rgba.b = f->b / max;
-            break;
-        }
-        case image::PixelType::RGBA_U8:
-            rgba.r = data[offset] / 255.0f;
-            rgba.g = data[offset + 1] / 255.0f;
-            rgba.b = data[offset + 2] / 255.0f;
-            rgba.a = data[offset + 3] / 255.0f;
-            break;
-        case image::PixelType::RGB_U16:
-        {
-            uint16_t* f = (uint16_t*)(&data[offset]);
-            rgba.r = f[0] / 65535.0f;
-            rgba.g = f[1] / 65535.0f;
-            rgba.b = f[2] / 65535.0f;
-            break;
-        }
-        case image::PixelType::RGBA_U16:
-        {
-            uint16_t* f = (uint16_t*)(&data[offset]);
-            rgba.r = f[0] / 65535.0f;
-            rgba.g = f[1] / 65535.0f;
-            rgba.b = f[2] / 65535.0f;
-            rgba.a = f[3] / 65535.0f;
-            break;
-        }
-        case image::PixelType::RGB_U32:
-        {
-            uint32_t* f = (uint32_t*)(&data[offset]);
-            constexpr float max =
-                static_cast<float>(std::numeric_limits<uint32_t>::max());
-            rgba.r = f[0] / max;
-            rgba.g = f[1] / max;
-            rgba.b = f[2] / max;
-            break;
-        }
-        case image::PixelType::RGBA_U32:
-        {
-            uint32_t* f = (uint32_t*)(&data[offset]);
-            constexpr float max =
-                static_cast<float>(std::numeric_limits<uint32_t>::max());
-            rgba.r = f[0] / max;
-            rgba.g = f[1] / max;
-            rgba.b = f[2] / max;
-            rgba.a = f[3] / max;
-            break;
-        }
-        case image::PixelType::RGB_F16:
-        {
-            half* f = (half*)(&data[offset]);
-            rgba.r = f[0];
-            rgba.g = f[1];
-            rgba.b = f[2];
-            break;
-        }
-        case image::PixelType::RGBA_F16:
-        {
-            half* f = (half*)(&data[offset]);
-            rgba.r = f[0];
-            rgba.g = f[1];
-            rgba.b = f[2];
-            rgba.a = f[3];
-            break;
-        }
-        case image::PixelType::RGB_F32:
-        {
-            float* f = (float*)(&data[offset]);
-            rgba.r = f[0];
-            rgba.g = f[1];
-            rgba.b = f[2];
-            break;
-        }
-        case image::PixelType::RGBA_F32:
-        {
-            float* f = (float*)(&data[offset]);
-            rgba.r = f[0];
-            rgba.g = f[1];
-            rgba.b = f[2];
-            rgba.a = f[3];
-            break;
-        }
-        case image::PixelType::YUV_420P_U8:
-        {
-            size_t Ysize = size.w * size.h;
-            size_t w2 = (size.w + 1) / 2;
-            size_t h2 = (size.h + 1) / 2;
-            size_t Usize = w2 * h2;
-            size_t offset2 = (Y / 2) * w2 + X / 2;
-            rgba.r = data[offset] / 255.0f;
-            rgba.g = data[Ysize + offset2] / 255.0f;
-            rgba.b = data[Ysize + Usize + offset2] / 255.0f;
-            color::checkLevels(rgba, videoLevels);
-            rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-            break;
-        }
-        case image::PixelType::YUV_422P_U8:
-        {
-            size_t Ysize = size.w * size.h;
-            size_t w2 = (size.w + 1) / 2;
-            size_t Usize = w2 * size.h;
-            size_t offset2 = Y * w2 + X / 2;
-            rgba.r = data[offset] / 255.0f;
-            rgba.g = data[Ysize + offset2] / 255.0f;
-            rgba.b = data[Ysize + Usize + offset2] / 255.0f;
-            color::checkLevels(rgba, videoLevels);
-            rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-            break;
-        }
-        case image::PixelType::YUV_444P_U8:
-        {
-            size_t Ysize = size.w * size.h;
-            rgba.r = data[offset] / 255.0f;
-            rgba.g = data[Ysize + offset] / 255.0f;
-            rgba.b = data[Ysize * 2 + offset] / 255.0f;
-            color::checkLevels(rgba, videoLevels);
-            rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-            break;
-        }
-        case image::PixelType::YUV_420P_U16: // Works
-        {
-            uint16_t* f = (uint16_t*)data;
-
-            size_t Ysize = size.w * size.h;
-            size_t w2 = (size.w + 1) / 2;
-            size_t h2 = (size.h + 1) / 2;
-            size_t Usize = w2 * h2;
-            size_t offset2 = (Y / 2) * w2 + X / 2;
-
-            rgba.r = f[offset] / 65535.0f;
-            rgba.g = f[Ysize + offset2] / 65535.0f;
-            rgba.b = f[Ysize + Usize + offset2] / 65535.0f;
-            color::checkLevels(rgba, videoLevels);
-            rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-            break;
-        }
-        case image::PixelType::YUV_422P_U16:
-        {
-            uint16_t* f = (uint16_t*)data;
-
-            size_t Ysize = size.w * size.h;
-            size_t w2 = (size.w + 1) / 2;
-            size_t Usize = w2 * size.h;
-            size_t offset2 = Y * w2 + X / 2;
-
-            rgba.r = f[offset] / 65535.0f;
-            rgba.g = f[Ysize + offset2] / 65535.0f;
-            rgba.b = f[Ysize + Usize + offset2] / 65535.0f;
-            color::checkLevels(rgba, videoLevels);
-            rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-            break;
-        }
-        case image::PixelType::YUV_444P_U16: // Works
-        {
-            uint16_t* f = (uint16_t*)data;
-            size_t Ysize = size.w * size.h;
-            rgba.r = f[offset] / 65535.0f;
-            rgba.g = f[Ysize + offset] / 65535.0f;
-            rgba.b = f[Ysize * 2 + offset] / 65535.0f;
-            color::checkLevels(rgba, videoLevels);
-            rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-            break;
-        }
-        default:
-            break;
-        }
-    }
-
-    void TimelineViewport::_calculateColorAreaRawValues(
-        area::Info& info) const noexcept
-    {
-        TLRENDER_P();
-
-        PixelToolBarClass* c = p.ui->uiPixelWindow;
-        BrightnessType brightness_type = (BrightnessType)c->uiLType->value();
-        int hsv_colorspace = c->uiBColorType->value() + 1;
-
-        int maxX = info.box.max.x;
-        int maxY = info.box.max.y;
-
-        for (int Y = info.box.y(); Y <= maxY; ++Y)
-        {
-            for (int X = info.box.x(); X <= maxX; ++X)
-            {
-                image::Color4f rgba, hsv;
-                rgba.r = rgba.g = rgba.b = rgba.a = 0.f;
-
-                math::Vector2i pos(X, Y);
-                for (const auto& video : p.videoData)
-                {
-                    for (const auto& layer : video.layers)
-                    {
-                        const auto& image = layer.image;
-                        if (!image->isValid())
-                            continue;
-
-                        image::Color4f pixel, pixelB;
-
-                        _getPixelValue(pixel, image, pos);
-
-                        const auto& imageB = layer.image;
-                        if (imageB->isValid())
-                        {
-                            _getPixelValue(pixelB, imageB, pos);
-
-                            if (layer.transition ==
-                                timeline::Transition::Dissolve)
-                            {
-                                float f2 = layer.transitionValue;
-                                float f = 1.0 - f2;
-                                pixel.r = pixel.r * f + pixelB.r * f2;
-                                pixel.g = pixel.g * f + pixelB.g * f2;
-                                pixel.b = pixel.b * f + pixelB.b * f2;
-                                pixel.a = pixel.a * f + pixelB.a * f2;
-                            }
-                        }
-                        rgba.r += pixel.r;
-                        rgba.g += pixel.g;
-                        rgba.b += pixel.b;
-                        rgba.a += pixel.a;
-                    }
-
-                    info.rgba.mean.r += rgba.r;
-                    info.rgba.mean.g += rgba.g;
-                    info.rgba.mean.b += rgba.b;
-                    info.rgba.mean.a += rgba.a;
-
-                    if (rgba.r < info.rgba.min.r)
-                        info.rgba.min.r = rgba.r;
-                    if (rgba.g < info.rgba.min.g)
-                        info.rgba.min.g = rgba.g;
-                    if (rgba.b < info.rgba.min.b)
-                        info.rgba.min.b = rgba.b;
-                    if (rgba.a < info.rgba.min.a)
-                        info.rgba.min.a = rgba.a;
-
-                    if (rgba.r > info.rgba.max.r)
-                        info.rgba.max.r = rgba.r;
-                    if (rgba.g > info.rgba.max.g)
-                        info.rgba.max.g = rgba.g;
-                    if (rgba.b > info.rgba.max.b)
-                        info.rgba.max.b = rgba.b;
-                    if (rgba.a > info.rgba.max.a)
-                        info.rgba.max.a = rgba.a;
-
-                    hsv = rgba_to_hsv(hsv_colorspace, rgba);
-                    hsv.a = calculate_brightness(rgba, brightness_type);
-                    hsv_to_info(hsv, info);
-                }
-            }
-        }
-
-        int num = info.box.w() * info.box.h();
-        info.rgba.mean.r /= num;
-        info.rgba.mean.g /= num;
-        info.rgba.mean.b /= num;
-        info.rgba.mean.a /= num;
-
-        info.rgba.diff.r = info.rgba.max.r - info.rgba.min.r;
-        info.rgba.diff.g = info.rgba.max.g - info.rgba.min.g;
-        info.rgba.diff.b = info.rgba.max.b - info.rgba.min.b;
-        info.rgba.diff.a = info.rgba.max.a - info.rgba.min.a;
-
-        info.hsv.mean.r /= num;
-        info.hsv.mean.g /= num;
-        info.hsv.mean.b /= num;
-        info.hsv.mean.a /= num;
-
-        info.hsv.diff.r = info.hsv.max.r - info.hsv.min.r;
-        info.hsv.diff.g = info.hsv.max.g - info.hsv.min.g;
-        info.hsv.diff.b = info.hsv.max.b - info.hsv.min.b;
-        info.hsv.diff.a = info.hsv.max.a - info.hsv.min.a;
+        std::vector<float> scratch;
+        decoder.decode(&rgba.r, pos.x, pos.y, 1, scratch);
     }
 
     void TimelineViewport::_mallocBuffer() const noexcept
@@ -2843,8 +2405,9 @@ namespace mrv
         TLRENDER_P();
 
         p.rawImage = true;
-        const math::Size2i& renderSize = getRenderSize();
-        unsigned dataSize = renderSize.w * renderSize.h * 4 * sizeof(float);
+        const math::Box2i& area = p.imageBox;
+        const size_t dataSize =
+            static_cast<size_t>(area.w()) * area.h() * 4 * sizeof(float);
 
         if (dataSize != p.rawImageSize || !p.image)
         {
@@ -2854,65 +2417,68 @@ namespace mrv
         }
     }
 
-    void TimelineViewport::_mapBuffer() const noexcept
+    void TimelineViewport::_mapBuffer(const math::Box2i& box) const noexcept
     {
         TLRENDER_P();
 
+        // Calculate just the selection.
+        const math::Size2i& renderSize = getRenderSize();
+        math::Box2i& area = p.imageBox;
+        area.min.x = std::max(box.min.x, 0);
+        area.min.y = std::max(box.min.y, 0);
+        area.max.x = std::min(box.max.x, renderSize.w - 1);
+        area.max.y = std::min(box.max.y, renderSize.h - 1);
+        if (area.max.x < area.min.x || area.max.y < area.min.y)
+            return;
+
         _mallocBuffer();
         if (!p.image)
             return;
 
-        const math::Size2i& renderSize = getRenderSize();
-        unsigned maxY = renderSize.h;
-        unsigned maxX = renderSize.w;
-        for (int Y = 0; Y < maxY; ++Y)
+        // Look up the decoder of each layer once and decode whole rows,
+        // in parallel.
+        const auto& mirror = p.displayOptions[0].mirror;
+        std::vector<std::vector<pixel::RowDecoder> > decoders;
+        for (const auto& video : p.videoData)
         {
-            for (int X = 0; X < maxX; ++X)
+            std::vector<pixel::RowDecoder> layers;
+            for (const auto& layer : video.layers)
             {
-                image::Color4f& rgba =
-                    (image::Color4f&)p.image[(X + maxX * Y) * 4];
-                rgba.r = rgba.g = rgba.b = rgba.a = 0.f;
+                if (layer.image && layer.image->isValid())
+                    layers.emplace_back(layer.image, mirror.x, mirror.y);
+            }
+            decoders.push_back(layers);
+        }
 
-                math::Vector2i pos(X, Y);
-                for (const auto& video : p.videoData)
+        const int W = area.w();
+        float* pixels = p.image;
+        ThreadPool::instance().parallel_rows(
+            area.min.y, area.max.y + 1, 16,
+            [&](int Y0, int Y1, unsigned)
+            {
+                std::vector<float> row(static_cast<size_t>(W) * 4);
+                std::vector<float> scratch;
+                for (int Y = Y0; Y < Y1; ++Y)
                 {
-                    for (const auto& layer : video.layers)
+                    float* out =
+                        pixels + static_cast<size_t>(Y - area.min.y) * W * 4;
+                    std::fill(out, out + W * 4, 0.F);
+                    for (const auto& layers : decoders)
                     {
-                        const auto& image = layer.image;
-                        if (!image->isValid())
-                            continue;
-
-                        image::Color4f pixel, pixelB;
-
-                        _getPixelValue(pixel, image, pos);
-
-                        const auto& imageB = layer.image;
-                        if (imageB->isValid())
+                        for (const auto& decoder : layers)
                         {
-                            _getPixelValue(pixelB, imageB, pos);
-
-                            if (layer.transition ==
-                                timeline::Transition::Dissolve)
-                            {
-                                float f2 = layer.transitionValue;
-                                float f = 1.0 - f2;
-                                pixel.r = pixel.r * f + pixelB.r * f2;
-                                pixel.g = pixel.g * f + pixelB.g * f2;
-                                pixel.b = pixel.b * f + pixelB.b * f2;
-                                pixel.a = pixel.a * f + pixelB.a * f2;
-                            }
+                            decoder.decode(
+                                row.data(), area.min.x, Y, W, scratch);
+                            for (int i = 0; i < W * 4; ++i)
+                                out[i] += row[i];
                         }
-                        rgba.r += pixel.r;
-                        rgba.g += pixel.g;
-                        rgba.b += pixel.b;
-                        rgba.a += pixel.a;
+
+                        // Swap red and blue, as the buffer is BGRA.
+                        for (int i = 0; i < W * 4; i += 4)
+                            std::swap(out[i], out[i + 2]);
                     }
-                    float tmp = rgba.r;
-                    rgba.r = rgba.b;
-                    rgba.b = tmp;
                 }
-            }
-        }
+            });
     }
 
     void TimelineViewport::_unmapBuffer() const noexcept
@@ -408,7 +408,7 @@ namespace mrv
         void _pushColorMessage(const std::string& command, float value);
 
         void _mallocBuffer() const noexcept;
-        void _mapBuffer() const noexcept;
+        void _mapBuffer(const math::Box2i& box) const noexcept;
         void _unmapBuffer() const noexcept;
 
         void _setFullScreen(bool active) noexcept;
@@ -416,7 +416,6 @@ namespace mrv
         void _getPixelValue(
             image::Color4f& rgba, const std::shared_ptr<image::Image>& image,
             const math::Vector2i& pos) const noexcept;
-        void _calculateColorAreaRawValues(area::Info& info) const noexcept;
 
         void
         hsv_to_info(const image::Color4f& hsv, area::Info& info) const noexcept;
@@ -9,6 +9,7 @@
 #include <tlTimeline/BackgroundOptions.h>
 #include <tlTimeline/Player.h>
 
+#include "mrvCore/mrvScopes.h"
 #include "mrvCore/mrvString.h"
 
 #include "mrvDraw/Annotation.h"
@@ -107,6 +108,10 @@ namespace mrv
         //! Color area information
         area::Info colorAreaInfo;
 
+        //! Histogram and vectorscope of the selection
+        scopes::HistogramData histogram;
+        scopes::VectorscopeData vectorscope;
+
         //! Safe Areas
         static bool safeAreas;
 
@@ -133,6 +138,10 @@ namespace mrv
         //! floats.
         float* image = nullptr;
 
+        //! Region of the render buffer held in image.  Only this region is
+        //! read back or calculated.
+        math::Box2i imageBox;
+
         //! Mark the buffer as raw, so we will delete with free().
         bool rawImage = true;
 
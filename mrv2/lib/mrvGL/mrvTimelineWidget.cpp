@@ -20,13 +20,16 @@
 #include <tlGL/Shader.h>
 
 #include "mrvCore/mrvFile.h"
+#include "mrvCore/mrvFilmstrip.h"
 #include "mrvCore/mrvHotkey.h"
+#include "mrvCore/mrvThumbnailCache.h"
 #include "mrvCore/mrvTimeObject.h"
 
 #include "mrvEdit/mrvEditCallbacks.h"
 #include "mrvEdit/mrvEditUtil.h"
 
 #include "mrvFl/mrvIO.h"
+#include "mrvFl/mrvScheduler.h"
 
 #include "mrvUI/mrvDesktop.h"
 
@@ -186,11 +189,12 @@ namespace mrv
 
         struct ThumbnailData
         {
-            ui::ThumbnailRequest request;
-            std::shared_ptr<image::Image> image;
+            ThumbnailRequest request;
+            otime::RationalTime time = time::invalidTime;
         };
         ThumbnailData thumbnail;
-        
+        std::unique_ptr<Filmstrip> filmstrip;
+
         Fl_Double_Window* thumbnailWindow = nullptr; // thumbnail window
         Fl_Box* box = nullptr;
 
@@ -305,7 +309,7 @@ namespace mrv
 
         _styleUpdate();
 
-        Fl::add_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
+        scheduler::add((Fl_Timeout_Handler)timerEvent_cb, this, kTimeout);
     }
 
     void TimelineWidget::setStyle(const std::shared_ptr<ui::Style>& style)
@@ -317,6 +321,7 @@ namespace mrv
     void TimelineWidget::hideThumbnail()
     {
         TLRENDER_P();
+        p.thumbnail.time = time::invalidTime;
         if (!p.thumbnailWindow)
             return;
         p.thumbnailWindow->hide();
@@ -325,7 +330,7 @@ namespace mrv
     TimelineWidget::~TimelineWidget()
     {
         _cancelThumbnailRequests();
-        Fl::remove_timeout(timerEvent_cb, this);
+        scheduler::remove(timerEvent_cb, this);
     }
 
     bool TimelineWidget::isEditable() const
@@ -576,22 +581,33 @@ namespace mrv
 
         repositionThumbnail();
 
-        file::Path path;
-        auto model = p.ui->app->filesModel();
-        auto Aitem = model->observeA()->get();
-        if (Aitem)
-            path = Aitem->path;
-        else
-            path = player->getPath();
-
         const image::Size size(kTHUMB_WIDTH, kTHUMB_HEIGHT);
         const auto& time = _posToTime(_toUI(Fl::event_x()));
+        if (time == p.thumbnail.time)
+            return 1;
+        p.thumbnail.time = time;
 
-        if (auto thumbnailSystem = p.thumbnailSystem.lock())
+        // Show the nearest sample of the filmstrip at once, and ask for
+        // the exact frame only if the sample is not it.
+        _cancelThumbnailRequests();
+        p.thumbnail.request = ThumbnailRequest();
+        otime::RationalTime sampleTime = time::invalidTime;
+        if (p.filmstrip)
         {
-            p.thumbnail.request = thumbnailSystem->getThumbnail(path, size.h, time);
+            if (auto image = p.filmstrip->getImage(time, &sampleTime))
+            {
+                p.box->bind_image(image);
+                p.box->redraw();
+            }
         }
-        
+
+        auto thumbnailSystem = p.thumbnailSystem.lock();
+        if (thumbnailSystem && sampleTime != time)
+        {
+            p.thumbnail.request = ThumbnailCache::instance().getThumbnail(
+                thumbnailSystem, _getThumbnailPath(), size.h, time);
+        }
+
         timeToText(buffer, time, _p->units);
         p.box->copy_label(buffer);
         return 1;
@@ -601,15 +617,23 @@ namespace mrv
     {
         TLRENDER_P();
         
-        if (auto thumbnailSystem = p.thumbnailSystem.lock())
+        if (p.thumbnail.request.future.valid())
         {
-            if (p.thumbnail.request.future.valid())
-            {
-                thumbnailSystem->cancelRequests({ p.thumbnail.request.id });
-            }
+            ThumbnailCache::instance().cancelRequests(
+                {p.thumbnail.request.id});
         }
     }
-    
+
+    file::Path TimelineWidget::_getThumbnailPath() const
+    {
+        TLRENDER_P();
+        auto model = p.ui->app->filesModel();
+        auto Aitem = model->observeA()->get();
+        if (Aitem)
+            return Aitem->path;
+        return p.player->player()->getPath();
+    }
+
     timelineui::ItemOptions TimelineWidget::getItemOptions() const
     {
         return _p->timelineWidget->getItemOptions();
@@ -641,6 +665,7 @@ namespace mrv
         {
             _cancelThumbnailRequests();
             p.box->image(nullptr);
+            p.filmstrip.reset();
 
             p.timeRange = time::invalidTimeRange;
             p.timelineWidget->setPlayer(nullptr);
@@ -1524,32 +1549,65 @@ namespace mrv
         if (p.thumbnail.request.future.valid() &&
             p.thumbnail.request.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
         {
-            if (auto image = p.thumbnail.request.future.get())
+            if (auto pixels = p.thumbnail.request.future.get())
             {
-                if (image::PixelType::RGBA_U8 == image->getPixelType())
-                {
-                    const int w = image->getWidth();
-                    const int h = image->getHeight();
-                    const int depth = 4;
+                if (p.filmstrip)
+                    p.filmstrip->addSample(p.thumbnail.time, pixels);
+                p.box->bind_image(new ThumbnailImage(pixels));
+                p.box->redraw();
+                repositionThumbnail();
+            }
+        }
+        
+    }
 
-                    uint8_t* pixelData = new uint8_t[w * h * depth];
+    void TimelineWidget::_filmstripUpdate()
+    {
+        TLRENDER_P();
 
-                    auto rgbImage = new Fl_RGB_Image(pixelData, w, h, depth);
-                    rgbImage->alloc_array = true;
+        auto thumbnailSystem = p.thumbnailSystem.lock();
+        if (!p.player || !thumbnailSystem ||
+            !p.ui->uiPrefs->uiPrefsTimelineThumbnails->value())
+        {
+            p.filmstrip.reset();
+            return;
+        }
 
-                    uint8_t* d = pixelData;
-                    const uint8_t* s = image->getData();
-                    for (int y = 0; y < h; ++y)
-                    {
-                        memcpy(d + (h - 1 - y) * w * 4, s + y * w * 4, w * 4);
-                    }
-                    p.box->bind_image(rgbImage);
-                    p.box->redraw();
-                    repositionThumbnail();
-                }
+        // The samples stay valid while the range of the timeline is within
+        // the one they were taken over, so the filmstrip is only made again
+        // for another file or a longer range.
+        const file::Path path = _getThumbnailPath();
+        const auto& timeRange = p.player->player()->getTimeRange();
+        if (!p.filmstrip || p.filmstrip->getPath().get() != path.get() ||
+            !p.filmstrip->getTimeRange().contains(timeRange))
+        {
+            p.filmstrip = std::make_unique<Filmstrip>(
+                thumbnailSystem, path, timeRange, kTHUMB_HEIGHT);
+        }
+
+        // Zooming in the timeline refines the samples of the range shown.
+        if (visible_r() && w() > 0)
+        {
+            const auto first = _posToTime(0);
+            const auto last = _posToTime(_toUI(w()));
+            if (time::isValid(first) && time::isValid(last))
+            {
+                p.filmstrip->setVisibleRange(
+                    otime::TimeRange::range_from_start_end_time_inclusive(
+                        first, last));
+            }
+        }
+
+        // Show a nearer sample while waiting for the exact frame.
+        if (p.filmstrip->tick() && p.thumbnail.request.future.valid() &&
+            p.thumbnailWindow && p.thumbnailWindow->visible())
+        {
+            if (auto image = p.filmstrip->getImage(p.thumbnail.time))
+            {
+                p.box->bind_image(image);
+                p.box->redraw();
             }
         }
-        
     }
 
     void TimelineWidget::timerEvent()
@@ -1560,6 +1618,8 @@ namespace mrv
 
         _thumbnailEvent();
 
+        _filmstripUpdate();
+
         if (_getSizeUpdate(p.timelineWindow))
         {
             _sizeHintEvent();
@@ -1572,7 +1632,7 @@ namespace mrv
             redraw();
         }
 
-        Fl::repeat_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
+        scheduler::repeat((Fl_Timeout_Handler)timerEvent_cb, this);
     }
 
     int TimelineWidget::handle(int event)
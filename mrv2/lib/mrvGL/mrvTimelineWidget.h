@@ -157,6 +157,7 @@ namespace mrv
         void _initializeGLResources();
         void _initializeGL();
         void _thumbnailEvent();
+        void _filmstripUpdate();
 
         void _createThumbnailWindow();
         void _getThumbnailPosition(int& X, int& Y, int& W, int& H);
@@ -164,6 +165,8 @@ namespace mrv
         void _setTimeUnits(tl::timeline::TimeUnits);
 
         void _cancelThumbnailRequests();
+
+        file::Path _getThumbnailPath() const;
         
         void _tickEvent();
         void _tickEvent(
@@ -17,6 +17,7 @@
 #include "mrvPanels/mrvPanelsCallbacks.h"
 
 #include "mrvNetwork/mrvClient.h"
+#include "mrvNetwork/mrvMessageCodec.h"
 #include "mrvNetwork/mrvDummyClient.h"
 
 namespace
@@ -68,7 +69,7 @@ namespace mrv
             std::thread* send = new std::thread(
                 [this]
                 {
-                    while (m_running)
+                    while (waitForSend())
                     {
                         sendMessages();
                     }
@@ -98,9 +99,8 @@ namespace mrv
                 message = m_send.front();
                 m_send.pop_front();
 
-                std::vector< uint8_t > v_bson =
-                    nlohmann::json::to_bson(message);
-                int messageLength = v_bson.size();
+                std::vector< uint8_t > data = encodeMessage(message);
+                int messageLength = data.size();
                 if (messageLength == 0)
                     continue;
 
@@ -121,7 +121,7 @@ namespace mrv
                 while (len < messageLength)
                 {
                     size = m_socket.sendBytes(
-                        v_bson.data() + len, messageLength - len);
+                        data.data() + len, messageLength - len);
                     if (size <= 0)
                     {
                         m_send.clear();
@@ -152,11 +152,27 @@ namespace mrv
 
     void Client::receiveMessages()
     {
+        // Wait for data instead of spinning, but wake up often enough to
+        // notice the client stopping.
+        try
+        {
+            if (!m_socket.poll(
+                    Poco::Timespan(0, 100000),
+                    Poco::Net::Socket::SELECT_READ |
+                        Poco::Net::Socket::SELECT_ERROR))
+                return;
+        }
+        catch (const Poco::Exception&)
+        {
+            return;
+        }
+
         if (m_socket.available() > 0)
         {
             std::lock_guard lk(m_receiveMutex);
             Message message = receiveMessage();
-            m_receive.push_back(message);
+            queueMessage(m_receive, message);
+            notifyReceive();
         }
     }
 } // namespace mrv
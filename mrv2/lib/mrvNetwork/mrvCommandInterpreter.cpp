@@ -2,6 +2,9 @@
 // mrv2
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
+#include <algorithm>
+#include <chrono>
+
 #include <tlCore/StringFormat.h>
 
 #include <FL/Fl_Multiline_Input.H>
@@ -10,6 +13,7 @@
 
 #include "mrvFl/mrvCallbacks.h"
 #include "mrvFl/mrvIO.h"
+#include "mrvFl/mrvScheduler.h"
 
 #ifdef TLRENDER_GL
 #    include "mrvGL/mrvGLUtil.h"
@@ -33,7 +37,6 @@
 namespace
 {
     const char* kModule = "inter";
-    const double kTimeout = 0.01;
 } // namespace
 
 namespace mrv
@@ -83,43 +86,132 @@ namespace mrv
     CommandInterpreter::CommandInterpreter(ViewerUI* gui) :
         ui(gui)
     {
-        Fl::add_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
+        _addCommands();
+        TCP::setReceiveCallback([this] { receiveEvent(); });
     }
 
     CommandInterpreter::~CommandInterpreter()
     {
-        Fl::remove_timeout((Fl_Timeout_Handler)timerEvent_cb, this);
+        TCP::setReceiveCallback(nullptr);
     }
 
     void CommandInterpreter::parse(const Message& message)
     {
         const std::string& c = message["command"];
-        auto app = ui->app;
-        auto prefs = ui->uiPrefs;
-        auto view = ui->uiView;
-        TimelinePlayer* player = nullptr;
+        auto i = commands.find(c);
+        if (i == commands.end())
+        {
+            // @todo: Unknown command
+            std::string err =
+                tl::string::Format("Ignored network command {0}.").arg(c);
+            LOG_ERROR(err);
+            return;
+        }
+
+        app = ui->app;
+        prefs = ui->uiPrefs;
+        view = ui->uiView;
+        player = nullptr;
         if (view)
             player = view->getTimelinePlayer();
 
-#ifndef NDEBUG
-        std::cerr << "Command: " << message << std::endl;
-#endif
+        Command& command = i->second;
+        if (!_canReceive(command.receive) ||
+            (command.requirement == Requires::Player && !player) ||
+            (command.requirement == Requires::View && !view))
+            return;
 
+        const auto start = std::chrono::steady_clock::now();
         try
         {
-            using namespace panel;
-
             tcp->lock();
+            command.handler(message);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR(e.what() << " message=" << message);
+        }
+        tcp->unlock();
 
-            if (c == "setPlayback")
-            {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
+        ++command.count;
+        command.time += std::chrono::steady_clock::now() - start;
+    }
+
+    std::vector<CommandInterpreter::Statistics>
+    CommandInterpreter::statistics() const
+    {
+        std::vector<Statistics> out;
+        for (const auto& i : commands)
+        {
+            if (i.second.count == 0)
+                continue;
+            Statistics s;
+            s.command = i.first;
+            s.coalescible = i.second.coalescible;
+            s.count = i.second.count;
+            s.time = i.second.time;
+            out.push_back(s);
+        }
+        std::sort(
+            out.begin(), out.end(),
+            [](const Statistics& a, const Statistics& b)
+            { return a.time > b.time; });
+        return out;
+    }
+
+    void CommandInterpreter::resetStatistics()
+    {
+        for (auto& i : commands)
+        {
+            i.second.count = 0;
+            i.second.time = std::chrono::duration<double>::zero();
+        }
+    }
 
+    bool CommandInterpreter::_canReceive(Receive value) const
+    {
+        switch (value)
+        {
+        case Receive::Media:
+            return prefs->ReceiveMedia->value();
+        case Receive::UI:
+            return prefs->ReceiveUI->value();
+        case Receive::PanAndZoom:
+            return prefs->ReceivePanAndZoom->value();
+        case Receive::Timeline:
+            return prefs->ReceiveTimeline->value();
+        case Receive::Color:
+            return prefs->ReceiveColor->value();
+        case Receive::Annotations:
+            return prefs->ReceiveAnnotations->value();
+        case Receive::Audio:
+            return prefs->ReceiveAudio->value();
+        default:
+        case Receive::Always:
+            return true;
+        }
+    }
+
+    void CommandInterpreter::_add(
+        const std::string& name, Receive receive, Requires requirement,
+        const std::function<void(const Message&)>& handler)
+    {
+        Command command;
+        command.receive = receive;
+        command.requirement = requirement;
+        command.coalescible = isCoalescible(name);
+        command.handler = handler;
+        commands[name] = command;
+    }
+
+    void CommandInterpreter::_addCommands()
+    {
+        using namespace panel;
+
+        _add(
+            "setPlayback", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
+            {
                 timeline::Playback value = message["value"];
 
                 switch (value)
@@ -135,123 +227,100 @@ namespace mrv
                     stop_cb(nullptr, ui);
                     break;
                 }
-            }
-            else if (c == "setLoop")
+            });
+
+        _add(
+            "setLoop", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 timeline::Loop value = message["value"];
                 player->setLoop(value);
-            }
-            else if (c == "Open File")
+            });
+
+        _add(
+            "Open File", Receive::Media, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveMedia->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 std::string fileName = message["fileName"];
                 std::string audioFileName = message["audioFileName"];
                 replace_path(fileName);
                 if (!audioFileName.empty())
                     replace_path(audioFileName);
                 app->open(fileName, audioFileName);
-            }
-            else if (c == "closeAll")
+            });
+
+        _add(
+            "closeAll", Receive::Media, Requires::Nothing,
+            [this](const Message& message)
             {
-                if (prefs->ReceiveMedia->value())
-                    close_all_cb(nullptr, ui);
-            }
-            else if (c == "closeCurrent")
+                close_all_cb(nullptr, ui);
+            });
+
+        _add(
+            "closeCurrent", Receive::Media, Requires::Nothing,
+            [this](const Message& message)
             {
-                if (prefs->ReceiveMedia->value())
-                    close_current_cb(nullptr, ui);
-            }
-            else if (c == "Media Items")
+                close_current_cb(nullptr, ui);
+            });
+
+        _add(
+            "Media Items", Receive::Media, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveMedia->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 syncMedia(message);
-            }
-            else if (c == "seek")
+            });
+
+        _add(
+            "seek", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 otime::RationalTime value = message["value"];
                 player->seek(value);
-            }
-            else if (c == "Timeline Key Press")
+            });
+
+        _add(
+            "Timeline Key Press", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const int key = message["value"];
                 const int modifiers = message["modifiers"];
                 ui->uiTimeline->keyPressEvent(key, modifiers);
-            }
-            else if (c == "Timeline Key Release")
+            });
+
+        _add(
+            "Timeline Key Release", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const int key = message["value"];
                 const int modifiers = message["modifiers"];
                 ui->uiTimeline->keyReleaseEvent(key, modifiers);
-            }
-            else if (c == "Timeline Mouse Press")
+            });
+
+        _add(
+            "Timeline Mouse Press", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const int button = message["button"];
                 const bool on = message["on"];
                 const int modifiers = message["modifiers"];
                 ui->uiTimeline->mousePressEvent(button, on, modifiers);
-            }
-            else if (c == "Timeline Mouse Move")
+            });
+
+        _add(
+            "Timeline Mouse Move", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 float X = message["X"];
                 X *= ui->uiTimeline->pixel_w();
                 float Y = message["Y"];
                 Y *= ui->uiTimeline->pixel_h();
                 ui->uiTimeline->mouseMoveEvent(X, Y);
-            }
-            else if (c == "Timeline Mouse Release")
+            });
+
+        _add(
+            "Timeline Mouse Release", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 float X = message["X"];
                 X *= ui->uiTimeline->pixel_w();
                 float Y = message["Y"];
@@ -260,246 +329,176 @@ namespace mrv
                 bool on = message["on"];
                 int modifiers = message["modifiers"];
                 ui->uiTimeline->mouseReleaseEvent(X, Y, button, on, modifiers);
-            }
-            else if (c == "Timeline Widget Scroll")
+            });
+
+        _add(
+            "Timeline Widget Scroll", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 float X = message["X"];
                 float Y = message["Y"];
                 int modifiers = message["modifiers"];
                 ui->uiTimeline->scrollEvent(X, Y, modifiers);
-            }
-            else if (c == "Timeline Fit")
+            });
+
+        _add(
+            "Timeline Fit", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 ui->uiTimeline->frameView();
-            }
-            else if (c == "setInOutRange")
+            });
+
+        _add(
+            "setInOutRange", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 otime::TimeRange value = message["value"];
                 player->setInOutRange(value);
-            }
-            else if (c == "setSpeed")
+            });
+
+        _add(
+            "setSpeed", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 double value = message["value"];
                 player->setSpeed(value);
-            }
-            else if (c == "setInPoint")
+            });
+
+        _add(
+            "setInPoint", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 player->setInPoint();
-            }
-            else if (c == "resetInPoint")
-            {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
+            });
 
-                player->resetInPoint();
-            }
-            else if (c == "setOutPoint")
+        _add(
+            "resetInPoint", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
+                player->resetInPoint();
+            });
 
-                player->setOutPoint();
-            }
-            else if (c == "resetInPoint")
+        _add(
+            "setOutPoint", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
+                player->setOutPoint();
+            });
 
+        _add(
+            "resetOutPoint", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
+            {
                 player->resetOutPoint();
-            }
-            else if (c == "setVideoLayer")
+            });
+
+        _add(
+            "setVideoLayer", Receive::Color, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveColor->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 int value = message["value"];
                 {
                     ui->uiColorChannel->value(value);
                     ui->uiColorChannel->do_callback();
                 }
-            }
-            else if (c == "Redraw Panel Thumbnails")
+            });
+
+        _add(
+            "Redraw Panel Thumbnails", Receive::Timeline, Requires::Nothing,
+            [](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 panel::redrawThumbnails();
-            }
-            else if (c == "setVolume")
+            });
+
+        _add(
+            "setVolume", Receive::Audio, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAudio->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 float value = message["value"];
 
                 player->setVolume(value);
                 TimelineClass* c = ui->uiTimeWindow;
                 c->uiVolume->value(value);
                 c->uiVolume->redraw();
-            }
-            else if (c == "setMute")
+            });
+
+        _add(
+            "setMute", Receive::Audio, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAudio->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
 
                 player->setMute(value);
                 TimelineClass* c = ui->uiTimeWindow;
                 c->uiAudioTracks->value(value);
                 c->uiAudioTracks->do_callback();
-            }
-            else if (c == "setAudioOffset")
+            });
+
+        _add(
+            "setAudioOffset", Receive::Audio, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAudio->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 double value = message["value"];
 
                 player->setAudioOffset(value);
-            }
-            else if (c == "start")
-            {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
+            });
 
-                player->start();
-            }
-            else if (c == "end")
+        _add(
+            "start", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
+                player->start();
+            });
 
-                player->end();
-            }
-            else if (c == "framePrev")
+        _add(
+            "end", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
+                player->end();
+            });
 
-                player->framePrev();
-            }
-            else if (c == "frameNext")
+        _add(
+            "framePrev", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveTimeline->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
+                player->framePrev();
+            });
 
+        _add(
+            "frameNext", Receive::Timeline, Requires::Player,
+            [this](const Message& message)
+            {
                 player->frameNext();
-            }
-            else if (c == "undo")
+            });
+
+        _add(
+            "undo", Receive::Annotations, Requires::View,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !view)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 ui->uiRedoDraw->activate();
                 view->undo();
-            }
-            else if (c == "redo")
+            });
+
+        _add(
+            "redo", Receive::Annotations, Requires::View,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !view)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 ui->uiUndoDraw->activate();
                 view->redo();
-            }
-            else if (c == "setEnvironmentMapOptions")
+            });
+
+        _add(
+            "setEnvironmentMapOptions", Receive::PanAndZoom, Requires::View,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceivePanAndZoom->value();
-                if (!receive || !view)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const EnvironmentMapOptions& o = message["value"];
                 view->setEnvironmentMapOptions(o);
-            }
-            else if (c == "setOCIOOptions")
+            });
+
+        _add(
+            "setOCIOOptions", Receive::Color, Requires::View,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveColor->value();
-                if (!receive || !view)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const tl::timeline::OCIOOptions& local = view->getOCIOOptions();
                 tl::timeline::OCIOOptions o = message["value"];
 
@@ -526,41 +525,53 @@ namespace mrv
                 ui->OCIOLook->value(index);
 
                 view->setOCIOOptions(o);
-            }
-            else if (c == "Display Options")
+            });
+
+        _add(
+            "Display Options", Receive::Color, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveColor->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const tl::timeline::DisplayOptions& o = message["value"];
                 app->setDisplayOptions(o);
                 ui->uiMain->fill_menu(ui->uiMenuBar);
-            }
-            else if (c == "setBackgroundOptions")
+            });
+
+        _add(
+            "setBackgroundOptions", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 const tl::timeline::BackgroundOptions& o = message["value"];
                 view->setBackgroundOptions(o);
                 ui->uiMain->fill_menu(ui->uiMenuBar);
-            }
-            else if (c == "setCompareOptions")
+            });
+
+        _add(
+            "setCompareOptions", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 const tl::timeline::CompareOptions& o = message["value"];
                 app->filesModel()->setCompareOptions(o);
-            }
-            else if (c == "setStereo3DOptions")
+            });
+
+        _add(
+            "setStereo3DOptions", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 const Stereo3DOptions& o = message["value"];
                 app->filesModel()->setStereo3DOptions(o);
-            }
-            else if (c == "Set A Index")
+            });
+
+        _add(
+            "Set A Index", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 int value = message["value"];
                 app->filesModel()->setA(value);
-            }
-            else if (c == "Set B Indexes")
+            });
+
+        _add(
+            "Set B Indexes", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 std::vector<int> values = message["value"];
                 app->filesModel()->clearB();
@@ -568,101 +579,80 @@ namespace mrv
                 {
                     app->filesModel()->setB(value, true);
                 }
-            }
-            else if (c == "Set Stereo Index")
+            });
+
+        _add(
+            "Set Stereo Index", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 int value = message["value"];
                 app->filesModel()->setStereo(value);
-            }
-            else if (c == "Image Options")
+            });
+
+        _add(
+            "Image Options", Receive::Color, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveColor->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const tl::timeline::ImageOptions& o = message["value"];
                 app->setImageOptions(o);
-            }
-            else if (c == "LUT Options")
+            });
+
+        _add(
+            "LUT Options", Receive::Color, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveColor->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const tl::timeline::LUTOptions& o = message["value"];
                 app->setLUTOptions(o);
-            }
-            else if (c == "gain")
+            });
+
+        _add(
+            "gain", Receive::Color, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveColor->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 float value = message["value"];
                 ui->uiGain->value(value);
                 ui->uiGain->do_callback();
-            }
-            else if (c == "gamma")
+            });
+
+        _add(
+            "gamma", Receive::Color, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveColor->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 float value = message["value"];
                 ui->uiGamma->value(value);
                 ui->uiGamma->do_callback();
-            }
-            else if (c == "Clear Note Annotation")
+            });
+
+        _add(
+            "Clear Note Annotation", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 clear_note_annotation_cb(ui);
                 if (annotationsPanel)
                 {
                     annotationsPanel->notes->value("");
                 }
-            }
-            else if (c == "Create Note Annotation")
+            });
+
+        _add(
+            "Create Note Annotation", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const std::string& text = message["value"];
                 add_note_annotation_cb(ui, text);
                 if (annotationsPanel)
                 {
                     annotationsPanel->notes->value(text.c_str());
                 }
-            }
-            else if (c == "Create Shape")
+            });
+
+        _add(
+            "Create Shape", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 auto annotation = player->getAnnotation();
                 if (!annotation)
-                {
-                    tcp->unlock();
                     return;
-                }
                 auto shape = draw::messageToShape(message["value"]);
                 annotation->shapes.push_back(shape);
 
@@ -670,21 +660,15 @@ namespace mrv
                 ui->uiMain->fill_menu(ui->uiMenuBar);
                 view->updateUndoRedoButtons();
                 view->redrawWindows();
-            }
-            else if (c == "Remove Shape")
+            });
+
+        _add(
+            "Remove Shape", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 auto annotation = player->getAnnotation();
                 if (!annotation)
-                {
-                    tcp->unlock();
                     return;
-                }
 
                 int index = message["value"];
                 if (index >= 0 && index < annotation->shapes.size())
@@ -694,27 +678,18 @@ namespace mrv
                     view->redrawWindows();
                     ui->uiTimeline->redraw();
                 }
-            }
-            else if (c == "Laser Fade")
+            });
+
+        _add(
+            "Laser Fade", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 auto annotation = player->getAnnotation();
                 if (!annotation)
-                {
-                    tcp->unlock();
                     return;
-                }
                 auto shape = annotation->lastShape();
                 if (!shape)
-                {
-                    tcp->unlock();
                     return;
-                }
 
                 // Start laser fading
                 LaserFadeData* laserData = new LaserFadeData;
@@ -729,117 +704,103 @@ namespace mrv
                 // Create annotation menus if not there already
                 ui->uiMain->fill_menu(ui->uiMenuBar);
                 view->redrawWindows();
-            }
-            else if (c == "Add Shape Point")
+            });
+
+        _add(
+            "Add Shape Point", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 auto annotation = player->getAnnotation();
                 if (!annotation)
-                {
-                    tcp->unlock();
                     return;
-                }
                 auto lastShape = annotation->lastShape();
                 if (!lastShape)
-                {
-                    tcp->unlock();
                     return;
-                }
                 auto shape = dynamic_cast< draw::PathShape* >(lastShape.get());
                 if (!shape)
-                {
-                    tcp->unlock();
                     return;
-                }
                 const draw::Point& value = message["value"];
                 shape->pts.push_back(value);
                 view->redrawWindows();
-            }
-            else if (c == "Update Shape")
+            });
+
+        _add(
+            "Add Shape Points", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
+                auto annotation = player->getAnnotation();
+                if (!annotation)
+                    return;
+                auto lastShape = annotation->lastShape();
+                if (!lastShape)
                     return;
+                auto shape = dynamic_cast< draw::PathShape* >(lastShape.get());
+                if (!shape)
+                    return;
+                for (const auto& point : message["value"])
+                {
+                    const draw::Point& value = point;
+                    shape->pts.push_back(value);
                 }
+                view->redrawWindows();
+            });
+
+        _add(
+            "Update Shape", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
+            {
                 auto annotation = player->getAnnotation();
                 if (!annotation)
-                {
-                    tcp->unlock();
                     return;
-                }
                 auto shape = draw::messageToShape(message["value"]);
                 annotation->shapes.pop_back();
                 annotation->shapes.push_back(shape);
                 view->updateUndoRedoButtons();
                 view->redrawWindows();
-            }
-            else if (c == "End Shape")
+            });
+
+        _add(
+            "End Shape", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 auto annotation = player->getAnnotation();
                 if (!annotation)
-                {
-                    tcp->unlock();
                     return;
-                }
                 auto shape = draw::messageToShape(message["value"]);
                 annotation->shapes.push_back(shape);
                 // Create annotation menus if not there already
                 ui->uiMain->fill_menu(ui->uiMenuBar);
                 view->updateUndoRedoButtons();
                 view->redrawWindows();
-            }
-            else if (c == "updateVideoCache")
+            });
+
+        _add(
+            "updateVideoCache", Receive::Always, Requires::Player,
+            [this](const Message& message)
             {
-                if (!player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const otime::RationalTime& time = message["value"];
                 player->updateVideoCache(time);
-            }
-            else if (c == "clearCache")
+            });
+
+        _add(
+            "clearCache", Receive::Always, Requires::Player,
+            [this](const Message& message)
             {
-                if (!player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 player->clearCache();
-            }
-            else if (c == "Create Annotation")
+            });
+
+        _add(
+            "Create Annotation", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool allFrames = message["value"];
                 player->createAnnotation(allFrames);
-            }
-            else if (c == "Annotations")
-            {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive || !player)
-                {
-                    tcp->unlock();
-                    return;
-                }
+            });
 
+        _add(
+            "Annotations", Receive::Annotations, Requires::Player,
+            [this](const Message& message)
+            {
                 const std::vector<draw::Annotation>& tmp = message["value"];
                 std::vector< std::shared_ptr<draw::Annotation> > annotations;
                 for (const auto& ann : tmp)
@@ -852,24 +813,17 @@ namespace mrv
                 player->setAllAnnotations(annotations);
                 ui->uiTimeline->redraw();
                 ui->uiMain->fill_menu(ui->uiMenuBar);
-            }
-            else if (c == "viewPosAndZoom")
-            {
-                bool receive = prefs->ReceivePanAndZoom->value();
-                if (!receive || !view)
-                {
-                    tcp->unlock();
-                    return;
-                }
+            });
 
+        _add(
+            "viewPosAndZoom", Receive::PanAndZoom, Requires::View,
+            [this](const Message& message)
+            {
                 float remoteZoom = message["zoom"];
 
                 // When all files are closed, we get an infinite zoom (null),
                 if (isinf(remoteZoom))
-                {
-                    tcp->unlock();
                     return;
-                }
 
                 const math::Vector2i& remoteViewPos = message["viewPos"];
                 const auto& remoteViewport = message["viewport"];
@@ -886,26 +840,20 @@ namespace mrv
                     viewport, localViewPos, localZoom);
 
                 view->setViewPosAndZoom(localViewPos, localZoom);
-            }
-            else if (c == "Show Annotations")
+            });
+
+        _add(
+            "Show Annotations", Receive::Annotations, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveAnnotations->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 view->setShowAnnotations(value);
-            }
-            else if (c == "Menu Bar")
+            });
+
+        _add(
+            "Menu Bar", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if (value)
                 {
@@ -917,15 +865,12 @@ namespace mrv
                 }
                 ui->uiRegion->layout();
                 ui->uiMain->fill_menu(ui->uiMenuBar);
-            }
-            else if (c == "Top Bar")
+            });
+
+        _add(
+            "Top Bar", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if (value)
                 {
@@ -937,15 +882,12 @@ namespace mrv
                 }
                 ui->uiRegion->layout();
                 ui->uiMain->fill_menu(ui->uiMenuBar);
-            }
-            else if (c == "Pixel Bar")
+            });
+
+        _add(
+            "Pixel Bar", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if (value)
                 {
@@ -957,15 +899,12 @@ namespace mrv
                 }
                 ui->uiRegion->layout();
                 ui->uiMain->fill_menu(ui->uiMenuBar);
-            }
-            else if (c == "Bottom Bar")
+            });
+
+        _add(
+            "Bottom Bar", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if (value)
                 {
@@ -977,15 +916,12 @@ namespace mrv
                 }
                 ui->uiRegion->layout();
                 ui->uiMain->fill_menu(ui->uiMenuBar);
-            }
-            else if (c == "Status Bar")
+            });
+
+        _add(
+            "Status Bar", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if (value)
                 {
@@ -996,15 +932,12 @@ namespace mrv
                     ui->uiStatusBar->hide();
                 }
                 ui->uiRegion->layout();
-            }
-            else if (c == "Action Bar")
+            });
+
+        _add(
+            "Action Bar", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if (value)
                 {
@@ -1016,183 +949,138 @@ namespace mrv
                 }
                 ui->uiViewGroup->layout();
                 ui->uiMain->fill_menu(ui->uiMenuBar);
-            }
-            else if (c == "Fullscreen")
+            });
+
+        _add(
+            "Fullscreen", Receive::UI, Requires::View,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive || !view)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 view->setFullScreenMode(value);
-            }
-            else if (c == "Presentation")
+            });
+
+        _add(
+            "Presentation", Receive::UI, Requires::View,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive || !view)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 view->setPresentationMode(value);
-            }
-            else if (c == "Selection Area")
+            });
+
+        _add(
+            "Selection Area", Receive::Color, Requires::View,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveColor->value();
-                if (!receive || !view)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 const math::Box2i& area = message["value"];
                 view->setSelectionArea(area);
-            }
-            else if (c == "One Panel Only")
+            });
+
+        _add(
+            "One Panel Only", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && panel::onlyOne()) ||
                     (value && !panel::onlyOne()))
                     toggle_one_panel_only_cb(nullptr, ui);
-            }
-            else if (c == "Color Panel")
+            });
+
+        _add(
+            "Color Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && colorPanel) || (value && !colorPanel))
                     color_panel_cb(nullptr, ui);
-            }
-            else if (c == "Annotations Panel")
+            });
+
+        _add(
+            "Annotations Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && annotationsPanel) ||
                     (value && !annotationsPanel))
                     annotations_panel_cb(nullptr, ui);
-            }
-            else if (c == "Background Panel")
+            });
+
+        _add(
+            "Background Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && backgroundPanel) || (value && !backgroundPanel))
                     background_panel_cb(nullptr, ui);
-            }
-            else if (c == "Color Area Panel")
+            });
+
+        _add(
+            "Color Area Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && colorAreaPanel) || (value && !colorAreaPanel))
                     color_area_panel_cb(nullptr, ui);
-            }
-            else if (c == "Compare Panel")
+            });
+
+        _add(
+            "Compare Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && comparePanel) || (value && !comparePanel))
                     compare_panel_cb(nullptr, ui);
-            }
-            else if (c == "Devices Panel")
+            });
+
+        _add(
+            "Devices Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && devicesPanel) || (value && !devicesPanel))
                     devices_panel_cb(nullptr, ui);
-            }
-            else if (c == "Environment Map Panel")
+            });
+
+        _add(
+            "Environment Map Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && environmentMapPanel) ||
                     (value && !environmentMapPanel))
                     environment_map_panel_cb(nullptr, ui);
-            }
-            else if (c == "Files Panel")
+            });
+
+        _add(
+            "Files Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && filesPanel) || (value && !filesPanel))
                     files_panel_cb(nullptr, ui);
-            }
-            else if (c == "Histogram Panel")
+            });
+
+        _add(
+            "Histogram Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && histogramPanel) || (value && !histogramPanel))
                     histogram_panel_cb(nullptr, ui);
-            }
-            else if (c == "Media Info Panel")
+            });
+
+        _add(
+            "Media Info Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && imageInfoPanel) || (value && !imageInfoPanel))
                     image_info_panel_cb(nullptr, ui);
-            }
-            else if (c == "setEditMode")
+            });
+
+        _add(
+            "setEditMode", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 EditMode value = message["value"];
                 editMode = value;
                 editModeH = message["height"];
@@ -1201,224 +1089,238 @@ namespace mrv
                     ui->uiView->resizeWindow();
 
                 set_edit_mode_cb(value, ui);
-            }
-            else if (c == "Network Panel")
+            });
+
+        _add(
+            "Network Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && networkPanel) || (value && !networkPanel))
                     network_panel_cb(nullptr, ui);
-            }
-            else if (c == "USD Panel")
+            });
+
+        _add(
+            "USD Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
 #ifdef TLRENDER_USD
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && usdPanel) || (value && !usdPanel))
                     usd_panel_cb(nullptr, ui);
 #endif
-            }
-            else if (c == "NDI Panel")
+            });
+
+        _add(
+            "NDI Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
 #ifdef TLRENDER_NDI
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && ndiPanel) || (value && !ndiPanel))
                     ndi_panel_cb(nullptr, ui);
 #endif
-            }
-            // Logs panel is not sent nor received.
-            else if (c == "Python Panel")
+            });
+
+        // Logs panel is not sent nor received.
+        _add(
+            "Python Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
 #ifdef MRV2_PYBIND11
                 bool value = message["value"];
                 if ((!value && pythonPanel) || (value && !pythonPanel))
                     python_panel_cb(nullptr, ui);
 #endif
-            }
-            else if (c == "Playlist Panel")
+            });
+
+        _add(
+            "Playlist Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && playlistPanel) || (value && !playlistPanel))
                     playlist_panel_cb(nullptr, ui);
-            }
-            else if (c == "Settings Panel")
+            });
+
+        _add(
+            "Settings Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && settingsPanel) || (value && !settingsPanel))
                     settings_panel_cb(nullptr, ui);
-            }
-            else if (c == "Vectorscope Panel")
+            });
+
+        _add(
+            "Vectorscope Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && vectorscopePanel) ||
                     (value && !vectorscopePanel))
                     vectorscope_panel_cb(nullptr, ui);
-            }
-            else if (c == "Stereo 3D Panel")
+            });
+
+        _add(
+            "Waveform Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
+            {
+                bool value = message["value"];
+                if ((!value && waveformPanel) || (value && !waveformPanel))
+                    waveform_panel_cb(nullptr, ui);
+            });
+
+        _add(
+            "Stereo 3D Panel", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 if ((!value && stereo3DPanel) || (value && !stereo3DPanel))
                     stereo3D_panel_cb(nullptr, ui);
-            }
-            else if (c == "setTimelineDisplayOptions")
+            });
+
+        _add(
+            "setTimelineDisplayOptions", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 timelineui::DisplayOptions value = message["value"];
                 ui->uiTimeline->setDisplayOptions(value);
-            }
-            else if (c == "Timeline/FrameView")
+            });
+
+        _add(
+            "Timeline/FrameView", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 ui->uiTimeline->frameView();
-            }
-            else if (c == "Timeline/ScrollToCurrentFrame")
+            });
+
+        _add(
+            "Timeline/ScrollToCurrentFrame", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 ui->uiTimeline->setScrollToCurrentFrame(value);
-            }
-            else if (c == "setTimelineEditable")
+            });
+
+        _add(
+            "setTimelineEditable", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
             {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
                 bool value = message["value"];
                 ui->uiTimeline->setEditable(value);
-            }
-            else if (c == "Clear Frame Annotations")
+            });
+
+        _add(
+            "Clear Frame Annotations", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 annotation_clear_cb(nullptr, ui);
-            }
-            else if (c == "Clear All Annotations")
+            });
+
+        _add(
+            "Clear All Annotations", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 annotation_clear_all_cb(nullptr, ui);
-            }
-            else if (c == "Create New Timeline")
+            });
+
+        _add(
+            "Create New Timeline", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 create_new_timeline_cb(ui);
-            }
-            else if (c == "Add Clip to Timeline")
+            });
+
+        _add(
+            "Add Clip to Timeline", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 int Aindex = message["value"];
                 add_clip_to_timeline_cb(Aindex, ui);
-            }
-            else if (c == "Edit/Frame/Cut")
+            });
+
+        _add(
+            "Edit/Frame/Cut", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_cut_frame_cb(nullptr, ui);
-            }
-            else if (c == "Edit/Frame/Copy")
+            });
+
+        _add(
+            "Edit/Frame/Copy", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_copy_frame_cb(nullptr, ui);
-            }
-            else if (c == "Edit/Frame/Paste")
+            });
+
+        _add(
+            "Edit/Frame/Paste", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_paste_frame_cb(nullptr, ui);
-            }
-            else if (c == "Edit/Frame/Insert")
+            });
+
+        _add(
+            "Edit/Frame/Insert", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_insert_frame_cb(nullptr, ui);
-            }
-            else if (c == "Edit/Audio Gap/Insert")
+            });
+
+        _add(
+            "Edit/Audio Gap/Insert", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_insert_audio_gap_cb(nullptr, ui);
-            }
-            else if (c == "Edit/Audio Gap/Remove")
+            });
+
+        _add(
+            "Edit/Audio Gap/Remove", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_remove_audio_gap_cb(nullptr, ui);
-            }
-            else if (c == "Edit/Slice")
+            });
+
+        _add(
+            "Edit/Slice", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_slice_clip_cb(nullptr, ui);
-            }
-            else if (c == "Edit/Remove")
+            });
+
+        _add(
+            "Edit/Remove", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_remove_clip_cb(nullptr, ui);
-            }
-            else if (c == "Edit/Undo")
+            });
+
+        _add(
+            "Edit/Undo", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_undo_cb(nullptr, ui);
-            }
-            else if (c == "Edit/Redo")
+            });
+
+        _add(
+            "Edit/Redo", Receive::Always, Requires::Nothing,
+            [this](const Message& message)
             {
                 edit_redo_cb(nullptr, ui);
-            }
-            else if (c == "setFilesPanelOptions")
-            {
-                bool receive = prefs->ReceiveUI->value();
-                if (!receive)
-                {
-                    tcp->unlock();
-                    return;
-                }
+            });
 
+        _add(
+            "setFilesPanelOptions", Receive::UI, Requires::Nothing,
+            [this](const Message& message)
+            {
                 const FilesPanelOptions& o = message["value"];
                 app->filesModel()->setFilesPanelOptions(o);
-            }
-            else if (c == "Protocol Version")
+            });
+
+        _add(
+            "Protocol Version", Receive::Always, Requires::Nothing,
+            [](const Message& message)
             {
                 int value = message["value"];
                 if (value != kProtocolVersion)
@@ -1431,43 +1333,19 @@ namespace mrv
                             .arg(kProtocolVersion);
                     LOG_ERROR(msg);
                 }
-            }
-            else
-            {
-                // @todo: Unknown command
-                std::string err =
-                    tl::string::Format("Ignored network command {0}.").arg(c);
-                LOG_ERROR(err);
-            }
-        }
-        catch (const std::exception& e)
-        {
-            LOG_ERROR(e.what() << " message=" << message);
-        }
-        tcp->unlock();
+            });
     }
 
-    void CommandInterpreter::timerEvent()
+    void CommandInterpreter::receiveEvent()
     {
-
         if (!tcp)
-        {
-            Fl::repeat_timeout(
-                kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
             return;
-        }
 
         while (tcp->hasReceive())
         {
             const Message& message = tcp->popMessage();
             parse(message);
         }
-        Fl::repeat_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
-    }
-
-    void CommandInterpreter::timerEvent_cb(void* arg)
-    {
-        CommandInterpreter* c = static_cast< CommandInterpreter* >(arg);
-        c->timerEvent();
+        scheduler::wakeUp();
     }
 } // namespace mrv
@@ -4,20 +4,62 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "mrvNetwork/mrvTCP.h"
 
 class ViewerUI;
+class PreferencesUI;
 
 namespace mrv
 {
+    class App;
     class FilesModelItem;
+    class TimelinePlayer;
+    class Viewport;
 
     class CommandInterpreter
     {
     public:
+        //! Preference that lets a command be received.
+        enum class Receive {
+            Always,
+            Media,
+            UI,
+            PanAndZoom,
+            Timeline,
+            Color,
+            Annotations,
+            Audio
+        };
+
+        //! What a command needs to be parsed.
+        enum class Requires { Nothing, Player, View };
+
+        //! Statistics of the messages of a command parsed.
+        struct Statistics
+        {
+            std::string command;
+            bool coalescible = false;
+            size_t count = 0;
+            std::chrono::duration<double> time =
+                std::chrono::duration<double>::zero();
+        };
+
         CommandInterpreter(ViewerUI*);
         ~CommandInterpreter();
 
+        //! Get the statistics of the commands parsed, sorted by the time
+        //! spent on them.
+        std::vector<Statistics> statistics() const;
+
+        //! Reset the statistics.
+        void resetStatistics();
+
     protected:
         void parse(const Message& message);
         void syncMedia(const Message& message);
@@ -27,13 +69,38 @@ namespace mrv
             const std::string& path, const std::string& audioPath,
             const FilesModelItem& item);
 
-    public:
-        void timerEvent();
-
-        static void timerEvent_cb(void* d);
+        //! Parse the messages received.
+        void receiveEvent();
 
     private:
+        struct Command
+        {
+            Receive receive = Receive::Always;
+            Requires requirement = Requires::Nothing;
+            bool coalescible = false;
+            std::function<void(const Message&)> handler;
+
+            size_t count = 0;
+            std::chrono::duration<double> time =
+                std::chrono::duration<double>::zero();
+        };
+
+        void _add(
+            const std::string& name, Receive, Requires,
+            const std::function<void(const Message&)>& handler);
+        void _addCommands();
+
+        bool _canReceive(Receive) const;
+
+        std::unordered_map<std::string, Command> commands;
+
         ViewerUI* ui;
+
+        //! State of the message being parsed, used by the handlers.
+        App* app = nullptr;
+        PreferencesUI* prefs = nullptr;
+        Viewport* view = nullptr;
+        TimelinePlayer* player = nullptr;
     };
 
 } // namespace mrv
@@ -61,7 +61,7 @@ namespace mrv
         std::thread* writer = new std::thread(
             [this, host]
             {
-                while (running())
+                while (waitForSend())
                 {
                     sendMessages();
                 }
@@ -134,14 +134,18 @@ namespace mrv
 
     void ConnectionHandler::sendMessages()
     {
-        try
+        // Take the queued messages, so new ones can be pushed while
+        // these are published.
+        std::list< Message > messages;
         {
             std::lock_guard lk(m_sendMutex);
-            while (hasSend())
-            {
-                auto message = m_send.front();
-                m_send.pop_front();
+            messages.swap(m_send);
+        }
 
+        try
+        {
+            for (const auto& message : messages)
+            {
                 messagePublisher.publish(message);
             }
         }
@@ -161,7 +165,8 @@ namespace mrv
             {
                 std::lock_guard lk(m_receiveMutex);
                 Message message = receiveMessage();
-                m_receive.push_back(message);
+                queueMessage(m_receive, message);
+                notifyReceive();
 
                 auto clientIP = getIP();
                 // Publish message to other subscribers
@@ -211,6 +216,7 @@ namespace mrv
 
     void ConnectionHandler::clearHandlers()
     {
+        messagePublisher.clear();
         for (auto handler : handlers)
         {
             delete handler;
@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <Poco/DeflatingStream.h>
+#include <Poco/InflatingStream.h>
+#include <Poco/MemoryStream.h>
+#include <Poco/StreamCopier.h>
+
+#include "mrvNetwork/mrvMessageCodec.h"
+
+namespace
+{
+    //! First byte of an encoded message.
+    enum Format : uint8_t {
+        kMessagePack = 1,
+        kMessagePackDeflated = 2,
+    };
+
+    //! Binary subtype of a list of points.
+    const uint8_t kPointsSubtype = 1;
+
+    //! Points are quantized to 1/kPointScale of a pixel.
+    const double kPointScale = 64.0;
+
+    //! Shortest list of points that is packed.
+    const size_t kMinPoints = 2;
+
+    //! Payloads of this size or more are compressed.
+    const size_t kDeflateSize = 4096;
+
+    //! Commands whose points are annotation strokes, the only ones that
+    //! can lose precision.
+    const char* kStrokeCommands[] = {
+        "Create Shape", "Update Shape", "End Shape", "Add Shape Points",
+        "Annotations"};
+
+    bool hasStrokes(const nlohmann::json& message)
+    {
+        if (!message.is_object() || !message.contains("command") ||
+            !message["command"].is_string())
+            return false;
+        const std::string& command =
+            message["command"].get_ref<const std::string&>();
+        return std::find(
+                   std::begin(kStrokeCommands), std::end(kStrokeCommands),
+                   command) != std::end(kStrokeCommands);
+    }
+
+    bool isPoint(const nlohmann::json& j)
+    {
+        return j.is_object() && j.size() == 2 && j.contains("x") &&
+               j.contains("y") && j["x"].is_number() && j["y"].is_number();
+    }
+
+    bool isPointList(const nlohmann::json& j)
+    {
+        if (!j.is_array() || j.size() < kMinPoints)
+            return false;
+        for (const auto& i : j)
+        {
+            if (!isPoint(i))
+                return false;
+        }
+        return true;
+    }
+
+    void writeVarint(std::vector<uint8_t>& out, int64_t value)
+    {
+        // Zigzag, so small negative deltas are short too.
+        uint64_t v = (static_cast<uint64_t>(value) << 1) ^
+                     static_cast<uint64_t>(value >> 63);
+        while (v >= 0x80)
+        {
+            out.push_back(static_cast<uint8_t>(v | 0x80));
+            v >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(v));
+    }
+
+    int64_t readVarint(const std::vector<uint8_t>& in, size_t& pos)
+    {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (pos >= in.size())
+                throw std::runtime_error("Truncated list of points");
+            const uint8_t byte = in[pos++];
+            v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return static_cast<int64_t>(v >> 1) ^
+                       -static_cast<int64_t>(v & 1);
+        }
+        throw std::runtime_error("Invalid list of points");
+    }
+
+    nlohmann::json packPoints(const nlohmann::json& points)
+    {
+        std::vector<uint8_t> data;
+        data.reserve(points.size() * 4 + 2);
+        writeVarint(data, static_cast<int64_t>(points.size()));
+        int64_t x = 0;
+        int64_t y = 0;
+        for (const auto& point : points)
+        {
+            const int64_t px =
+                std::llround(point["x"].get<double>() * kPointScale);
+            const int64_t py =
+                std::llround(point["y"].get<double>() * kPointScale);
+            writeVarint(data, px - x);
+            writeVarint(data, py - y);
+            x = px;
+            y = py;
+        }
+        return nlohmann::json::binary(std::move(data), kPointsSubtype);
+    }
+
+    nlohmann::json unpackPoints(const nlohmann::json::binary_t& data)
+    {
+        size_t pos = 0;
+        const int64_t count = readVarint(data, pos);
+        if (count < 0 || static_cast<size_t>(count) > data.size())
+            throw std::runtime_error("Invalid list of points");
+
+        nlohmann::json out = nlohmann::json::array();
+        int64_t x = 0;
+        int64_t y = 0;
+        for (int64_t i = 0; i < count; ++i)
+        {
+            x += readVarint(data, pos);
+            y += readVarint(data, pos);
+            out.push_back({{"x", x / kPointScale}, {"y", y / kPointScale}});
+        }
+        return out;
+    }
+
+    nlohmann::json pack(const nlohmann::json& j)
+    {
+        if (isPointList(j))
+            return packPoints(j);
+        if (j.is_object())
+        {
+            nlohmann::json out = nlohmann::json::object();
+            for (auto i = j.begin(); i != j.end(); ++i)
+                out[i.key()] = pack(i.value());
+            return out;
+        }
+        if (j.is_array())
+        {
+            nlohmann::json out = nlohmann::json::array();
+            for (const auto& i : j)
+                out.push_back(pack(i));
+            return out;
+        }
+        return j;
+    }
+
+    void unpack(nlohmann::json& j)
+    {
+        if (j.is_binary())
+        {
+            const auto& data = j.get_binary();
+            if (data.has_subtype() && data.subtype() == kPointsSubtype)
+                j = unpackPoints(data);
+        }
+        else if (j.is_structured())
+        {
+            for (auto& i : j)
+                unpack(i);
+        }
+    }
+
+    bool isBSON(const std::vector<uint8_t>& data)
+    {
+        if (data.size() < 5)
+            return false;
+        const uint32_t size = data[0] | (data[1] << 8) | (data[2] << 16) |
+                              (static_cast<uint32_t>(data[3]) << 24);
+        return size == data.size() && data.back() == 0;
+    }
+} // namespace
+
+namespace mrv
+{
+    std::vector<uint8_t> encodeMessage(const Message& message)
+    {
+        std::vector<uint8_t> out;
+        out.push_back(kMessagePack);
+        if (hasStrokes(message))
+            nlohmann::json::to_msgpack(pack(message), out);
+        else
+            nlohmann::json::to_msgpack(message, out);
+        if (out.size() < kDeflateSize)
+            return out;
+
+        std::ostringstream s;
+        {
+            Poco::DeflatingOutputStream deflate(
+                s, Poco::DeflatingStreamBuf::STREAM_ZLIB);
+            deflate.write(
+                reinterpret_cast<const char*>(out.data() + 1), out.size() - 1);
+            deflate.close();
+        }
+        const std::string& deflated = s.str();
+        if (deflated.size() + 1 >= out.size())
+            return out;
+
+        out.resize(deflated.size() + 1);
+        out[0] = kMessagePackDeflated;
+        memcpy(out.data() + 1, deflated.data(), deflated.size());
+        return out;
+    }
+
+    Message decodeMessage(const std::vector<uint8_t>& data)
+    {
+        if (isBSON(data))
+            return nlohmann::json::from_bson(data);
+        if (data.empty())
+            throw std::runtime_error("Empty message");
+
+        Message out;
+        switch (data[0])
+        {
+        case kMessagePack:
+            out = nlohmann::json::from_msgpack(data.begin() + 1, data.end());
+            break;
+        case kMessagePackDeflated:
+        {
+            Poco::MemoryInputStream s(
+                reinterpret_cast<const char*>(data.data() + 1),
+                data.size() - 1);
+            Poco::InflatingInputStream inflate(
+                s, Poco::InflatingStreamBuf::STREAM_ZLIB);
+
+            // The size is capped, so a small message cannot inflate into
+            // all the memory.
+            std::string inflated;
+            char buffer[65536];
+            while (inflate)
+            {
+                inflate.read(buffer, sizeof(buffer));
+                inflated.append(buffer, inflate.gcount());
+                if (inflated.size() > kMaxMessageSize)
+                    throw std::runtime_error("Message too large");
+            }
+            out = nlohmann::json::from_msgpack(inflated);
+            break;
+        }
+        default:
+            throw std::runtime_error("Unknown message format");
+        }
+        unpack(out);
+        return out;
+    }
+
+} // namespace mrv
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mrvNetwork/mrvMessage.h"
+
+namespace mrv
+{
+    //! Largest message that is received or inflated, in bytes.
+    const size_t kMaxMessageSize = 64 * 1024 * 1024;
+
+    /**
+     * Encode a message for the wire.
+     *
+     * Messages are sent as MessagePack instead of BSON.  Lists of points
+     * of the annotation stroke commands are quantized to 1/64th of a
+     * pixel and stored as variable length deltas, and large payloads are
+     * compressed with zlib.
+     */
+    std::vector<uint8_t> encodeMessage(const Message& message);
+
+    //! Decode a message from the wire.  Messages in BSON, sent by older
+    //! versions, are decoded too.  Throws on invalid data.
+    Message decodeMessage(const std::vector<uint8_t>& data);
+
+} // namespace mrv
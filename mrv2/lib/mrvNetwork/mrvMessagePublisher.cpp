@@ -2,112 +2,277 @@
 // mrv2
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
+#include <algorithm>
+#include <cstring>
+
 #include <Poco/Net/StreamSocket.h>
 #include <Poco/Net/NetException.h>
+#include <Poco/Timespan.h>
 
 #include <tlCore/StringFormat.h>
 
+#include "mrvNetwork/mrvMessageCodec.h"
 #include "mrvNetwork/mrvMessagePublisher.h"
 
 namespace
 {
     const char* kModule = "publisher";
-}
+
+    //! Bytes queued for a client before it is disconnected.
+    const size_t kMaxQueuedBytes = 32 * 1024 * 1024;
+
+    //! Bytes sent to a client at a time, so the clients are served in
+    //! turns.
+    const size_t kChunkSize = 16 * 1024;
+
+    //! How often the sender thread checks for new frames while waiting
+    //! for slow clients.
+    const Poco::Timespan kSelectTimeout(0, 100000);
+} // namespace
 
 namespace mrv
 {
+    MessagePublisher::~MessagePublisher()
+    {
+        clear();
+    }
 
     //! Relay a message from a client to all clients except the one
     //! that sent the original message
     void
     MessagePublisher::publish(const Message& message, const ClientIP& clientIP)
     {
-        int size;
-        auto it = sockets.begin();
-        while (it != sockets.end())
+        std::vector< uint8_t > data;
+        try
         {
-            if (it->first == clientIP)
-            {
-                ++it;
-                continue;
-            }
+            data = encodeMessage(message);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("std::exception caught: " << e.what());
+            return;
+        }
 
-            Poco::Net::StreamSocket& m_socket = it->second;
+        const int messageLength = data.size();
+        if (messageLength <= 0)
+            return;
 
-            try
-            {
-                std::vector< uint8_t > v_bson =
-                    nlohmann::json::to_bson(message);
+        auto frame = std::make_shared< std::vector<uint8_t> >(
+            sizeof(messageLength) + messageLength);
+        const int messageLengthHtoNL = htonl(messageLength);
+        memcpy(frame->data(), &messageLengthHtoNL, sizeof(messageLength));
+        memcpy(
+            frame->data() + sizeof(messageLength), data.data(),
+            messageLength);
 
-                int messageLength = v_bson.size();
-                if (messageLength <= 0)
-                {
+        {
+            std::lock_guard lk(mutex);
+            std::vector<ClientIP> slow;
+            for (auto& i : subscribers)
+            {
+                if (i.first == clientIP)
                     continue;
-                }
 
-                // Send command
-                int messageLengthHtoNL = htonl(messageLength);
-
-                size = m_socket.sendBytes(
-                    &messageLengthHtoNL, sizeof(messageLength));
-                if (size <= 0)
+                Subscriber& subscriber = i.second;
+                if (subscriber.queuedBytes + frame->size() > kMaxQueuedBytes)
                 {
-                    it = sockets.erase(it);
+                    slow.push_back(i.first);
                     continue;
                 }
-
-                int len = 0;
-                while (len < messageLength)
-                {
-                    size = m_socket.sendBytes(
-                        v_bson.data() + len, messageLength - len);
-                    if (size <= 0)
-                    {
-                        continue;
-                    }
-                    len += size;
-                }
-            }
-            catch (const Poco::Exception& ex)
-            {
-                // Handle the exception here, which indicates the client
-                // disconnect event
-                LOG_ERROR("Poco::Exception caught: " << ex.displayText());
-                it = remove(it->first);
-                continue;
+                subscriber.frames.push_back(frame);
+                subscriber.queuedBytes += frame->size();
             }
-            catch (const std::exception& e)
+            for (const auto& ip : slow)
             {
-                // Handle the exception here, which indicates the client
-                // disconnect event
-                LOG_ERROR("std::exception caught: " << e.what());
-                it = remove(it->first);
-                continue;
+                LOG_ERROR(
+                    tl::string::Format(_("{0} is too slow.  Disconnecting."))
+                        .arg(ipToHostname(ip)));
+                evict(ip);
             }
-
-            ++it;
         }
+        cv.notify_one();
     }
 
     void
     MessagePublisher::add(const ClientIP& ip, Poco::Net::StreamSocket& socket)
     {
-        sockets[ip] = socket;
+        // Writes take what the socket can hold and return, and the
+        // connection handler waits for its reads.
+        socket.setBlocking(false);
+
+        std::lock_guard lk(mutex);
+        Subscriber subscriber;
+        subscriber.socket = socket;
+        subscriber.id = ++nextId;
+        subscribers[ip] = subscriber;
 
-        Poco::Timespan timeout(2, 0); // 2 Sec
-        socket.setSendTimeout(timeout);
+        if (!running)
+        {
+            if (thread.joinable())
+                thread.join();
+            running = true;
+            thread = std::thread([this] { run(); });
+        }
     }
 
-    IPsToSocket::iterator MessagePublisher::remove(const ClientIP& ip)
+    void MessagePublisher::remove(const ClientIP& ip)
     {
-        auto it = sockets.find(ip);
-        if (it != sockets.end())
+        std::lock_guard lk(mutex);
+        auto it = subscribers.find(ip);
+        if (it != subscribers.end())
         {
             std::string msg =
                 tl::string::Format(_("Removing {0} from message publisher."))
                     .arg(ipToHostname(ip));
-            it = sockets.erase(it);
+            LOG_INFO(msg);
+            subscribers.erase(it);
+        }
+    }
+
+    void MessagePublisher::clear()
+    {
+        {
+            std::lock_guard lk(mutex);
+            subscribers.clear();
+            running = false;
+        }
+        cv.notify_one();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void MessagePublisher::evict(const ClientIP& ip)
+    {
+        auto it = subscribers.find(ip);
+        if (it == subscribers.end())
+            return;
+
+        // Shutting down the socket makes its connection handler notice
+        // the disconnection and stop.
+        try
+        {
+            it->second.socket.shutdown();
+        }
+        catch (const Poco::Exception&)
+        {
+        }
+        subscribers.erase(it);
+    }
+
+    void MessagePublisher::run()
+    {
+        while (true)
+        {
+            Poco::Net::Socket::SocketList readList, writeList, exceptList;
+            {
+                std::unique_lock lk(mutex);
+                cv.wait(
+                    lk,
+                    [this]
+                    {
+                        if (!running)
+                            return true;
+                        for (const auto& i : subscribers)
+                        {
+                            if (!i.second.frames.empty())
+                                return true;
+                        }
+                        return false;
+                    });
+                if (!running)
+                    return;
+
+                for (const auto& i : subscribers)
+                {
+                    if (!i.second.frames.empty())
+                        writeList.push_back(i.second.socket);
+                }
+            }
+
+            try
+            {
+                if (Poco::Net::Socket::select(
+                        readList, writeList, exceptList, kSelectTimeout) <= 0)
+                    continue;
+            }
+            catch (const Poco::Exception& ex)
+            {
+                LOG_ERROR("Poco::Exception caught: " << ex.displayText());
+                continue;
+            }
+
+            // Send a chunk to each client that is ready.  Only this thread
+            // removes frames, so the first frame of a client does not
+            // change while the lock is released.
+            for (auto& socket : writeList)
+            {
+                ClientIP ip;
+                uint64_t id = 0;
+                Frame frame;
+                size_t offset = 0;
+                {
+                    std::lock_guard lk(mutex);
+                    for (auto& i : subscribers)
+                    {
+                        if (i.second.socket == socket &&
+                            !i.second.frames.empty())
+                        {
+                            ip = i.first;
+                            id = i.second.id;
+                            frame = i.second.frames.front();
+                            offset = i.second.offset;
+                            break;
+                        }
+                    }
+                }
+                if (!frame)
+                    continue;
+
+                // Negative when the socket cannot take more yet.
+                int size = 0;
+                try
+                {
+                    Poco::Net::StreamSocket stream(socket);
+                    size = stream.sendBytes(
+                        frame->data() + offset,
+                        static_cast<int>(
+                            std::min(frame->size() - offset, kChunkSize)));
+                }
+                catch (const Poco::TimeoutException&)
+                {
+                    // Older Poco versions throw instead of returning.
+                    size = -1;
+                }
+                catch (const Poco::Exception& ex)
+                {
+                    // Handle the exception here, which indicates the client
+                    // disconnect event
+                    LOG_ERROR("Poco::Exception caught: " << ex.displayText());
+                }
+
+                std::lock_guard lk(mutex);
+                // The client may have reconnected from the same address
+                // while the lock was released.
+                auto it = subscribers.find(ip);
+                if (it == subscribers.end() || it->second.id != id)
+                    continue;
+                if (size == 0)
+                {
+                    evict(ip);
+                    continue;
+                }
+                if (size < 0)
+                    continue;
+
+                Subscriber& subscriber = it->second;
+                subscriber.offset += size;
+                if (subscriber.offset >= frame->size())
+                {
+                    subscriber.frames.pop_front();
+                    subscriber.queuedBytes -= frame->size();
+                    subscriber.offset = 0;
+                }
+            }
         }
-        return it;
     }
 } // namespace mrv
@@ -5,7 +5,12 @@
 // Example of a basic pub/sub mechanism
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -18,23 +23,56 @@ namespace mrv
     using Poco::Net::Socket;
 
     typedef std::string ClientIP;
-    typedef std::unordered_map<ClientIP, Poco::Net::StreamSocket> IPsToSocket;
 
+    /**
+     * Relays messages to the connected clients.
+     *
+     * Each message is encoded once into a frame shared by all the
+     * clients.  Every client has its own queue of frames, which a sender
+     * thread writes to the sockets that are ready.  The sockets do not
+     * block, so a slow client does not delay the others.  A client that
+     * falls too far behind is disconnected.
+     */
     class MessagePublisher
     {
     public:
+        ~MessagePublisher();
+
         //! Relay a message from a client to all clients except the one
         //! that sent the original message
         void publish(const Message& message, const ClientIP& client = "");
 
         void add(const ClientIP& ip, Poco::Net::StreamSocket& socket);
 
-        IPsToSocket::iterator remove(const ClientIP& ip);
+        void remove(const ClientIP& ip);
+
+        //! Remove all clients and stop the sender thread.
+        void clear();
 
     private:
-        void shutdown(Poco::Net::StreamSocket& socket);
+        //! Length header and encoded message.
+        typedef std::shared_ptr<const std::vector<uint8_t> > Frame;
+
+        struct Subscriber
+        {
+            Poco::Net::StreamSocket socket;
+            uint64_t id = 0; //!< Tells apart clients reconnecting.
+            std::deque<Frame> frames;
+            size_t offset = 0; //!< Bytes of the first frame already sent.
+            size_t queuedBytes = 0;
+        };
+
+        void run();
+
+        void evict(const ClientIP& ip);
+
+        std::unordered_map<ClientIP, Subscriber> subscribers;
+        uint64_t nextId = 0;
 
-        IPsToSocket sockets;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::thread thread;
+        bool running = false;
     };
 
 } // namespace mrv
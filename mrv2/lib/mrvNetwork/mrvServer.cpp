@@ -52,19 +52,16 @@ namespace mrv
             });
 
         m_running = true;
-        std::thread* disconnectionThread = new std::thread(
-            [this]
-            {
-                while (running())
-                {
-                    // m_running is volatile so this loop is not optimized
-                }
-                reactor.stop(); // release reactor.run()
-            });
-        m_threads.push_back(disconnectionThread);
         m_threads.push_back(connectionThread);
     }
 
+    void Server::stop()
+    {
+        // Release reactor.run(), so the connection thread can be joined.
+        reactor.stop();
+        TCP::stop();
+    }
+
     bool Server::hasReceive() const
     {
         ConnectionHandler* handler = ConnectionHandler::handler();
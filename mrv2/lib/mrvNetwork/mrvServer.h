@@ -21,6 +21,8 @@ namespace mrv
 
         void start();
 
+        void stop() override;
+
         bool hasReceive() const override;
 
         void pushMessage(const Message& message) override;
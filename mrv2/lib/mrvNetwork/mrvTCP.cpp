@@ -2,14 +2,23 @@
 // mrv2
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
+#include <atomic>
 #include <iostream>
 
 #include <tlCore/Time.h>
 
+#include <FL/Fl.H>
+
 #include "mrvFl/mrvIO.h"
 
 #include "mrvNetwork/mrvTCP.h"
 
+#ifdef MRV2_NETWORK
+#    include <Poco/Exception.h>
+
+#    include "mrvNetwork/mrvMessageCodec.h"
+#endif
+
 namespace
 {
     const char* kModule = "tcp";
@@ -19,6 +28,26 @@ namespace
 #else
     const std::string kHostsFile = "/etc/hosts";
 #endif
+
+    //! Commands whose messages carry the whole state they set, so only
+    //! the latest one needs to be sent or parsed.
+    bool isStateCommand(const std::string& command)
+    {
+        return (
+            command == "seek" || command == "viewPosAndZoom" ||
+            command == "gain" || command == "gamma" ||
+            command == "Timeline Mouse Move");
+    }
+
+    std::function<void()> receiveCallback;
+    std::atomic<bool> receivePending(false);
+
+    void receive_cb(void*)
+    {
+        receivePending = false;
+        if (receiveCallback)
+            receiveCallback();
+    }
 } // namespace
 
 namespace mrv
@@ -57,6 +86,11 @@ namespace mrv
         return ip;
     }
 
+    bool isCoalescible(const std::string& command)
+    {
+        return isStateCommand(command) || command == "Add Shape Point";
+    }
+
     TCP* tcp = nullptr;
 
     std::mutex TCP::m_receiveMutex;
@@ -80,7 +114,11 @@ namespace mrv
 
     void TCP::stop()
     {
-        m_running = false;
+        {
+            std::lock_guard lk(m_sendMutex);
+            m_running = false;
+        }
+        m_sendCV.notify_all();
         for (auto t : m_threads)
         {
             if (t->joinable())
@@ -105,8 +143,55 @@ namespace mrv
     {
         if (m_lock)
             return;
-        std::lock_guard lk(m_sendMutex);
-        m_send.push_back(message);
+        {
+            std::lock_guard lk(m_sendMutex);
+            queueMessage(m_send, message);
+        }
+        m_sendCV.notify_one();
+    }
+
+    void
+    TCP::queueMessage(std::list< Message >& messages, const Message& message)
+    {
+        // Only the last message queued is merged, so messages are never
+        // reordered around other commands.
+        if (!messages.empty() && message.is_object())
+        {
+            Message& last = messages.back();
+            const std::string command = message.value("command", "");
+            const std::string lastCommand = last.value("command", "");
+            if (isStateCommand(command) && command == lastCommand)
+            {
+                last = message;
+                return;
+            }
+            if (command == "Add Shape Point")
+            {
+                if (lastCommand == "Add Shape Point")
+                {
+                    Message points = {
+                        {"command", "Add Shape Points"},
+                        {"value",
+                         nlohmann::json::array(
+                             {last["value"], message["value"]})}};
+                    last = points;
+                    return;
+                }
+                if (lastCommand == "Add Shape Points")
+                {
+                    last["value"].push_back(message["value"]);
+                    return;
+                }
+            }
+        }
+        messages.push_back(message);
+    }
+
+    bool TCP::waitForSend()
+    {
+        std::unique_lock lk(m_sendMutex);
+        m_sendCV.wait(lk, [this] { return !m_send.empty() || !m_running; });
+        return m_running;
     }
 
     void TCP::pushMessage(const std::string& command, bool value)
@@ -189,6 +274,19 @@ namespace mrv
         pushMessage(message);
     }
 
+    void TCP::setReceiveCallback(const std::function<void()>& value)
+    {
+        receiveCallback = value;
+    }
+
+    void TCP::notifyReceive()
+    {
+        // Only one wake up is pending at a time, so a burst of messages
+        // is parsed in one go.
+        if (!receivePending.exchange(true) && Fl::awake(receive_cb, nullptr))
+            receivePending = false;
+    }
+
     Message TCP::popMessage()
     {
         std::lock_guard lk(m_receiveMutex);
@@ -197,6 +295,40 @@ namespace mrv
         return message;
     }
 
+    int TCP::receiveAll(void* data, int size)
+    {
+        int len = 0;
+#ifdef MRV2_NETWORK
+        // The sockets of the server do not block, so the message
+        // publisher never waits on a slow client.
+        const Poco::Timespan timeout(2, 0);
+        uint8_t* p = static_cast<uint8_t*>(data);
+        while (len < size)
+        {
+            int n = -1;
+            try
+            {
+                n = m_socket.receiveBytes(p + len, size - len);
+            }
+            catch (const Poco::TimeoutException&)
+            {
+                // Older Poco versions throw instead of returning.
+                if (m_socket.getBlocking())
+                    throw;
+            }
+            if (n > 0)
+            {
+                len += n;
+                continue;
+            }
+            if (n == 0 || m_socket.getBlocking() ||
+                !m_socket.poll(timeout, Poco::Net::Socket::SELECT_READ))
+                break;
+        }
+#endif
+        return len;
+    }
+
     Message TCP::receiveMessage()
     {
         int len = 0;
@@ -209,13 +341,15 @@ namespace mrv
         try
         {
             // Read the message length header from the socket
-            size = m_socket.receiveBytes(&messageLength, sizeof(messageLength));
+            size = receiveAll(&messageLength, sizeof(messageLength));
 
             // Convert the message length from network byte order to host
             // byte order
             messageLength = ntohl(messageLength);
 
-            if (messageLength <= 0 || size <= 0)
+            if (messageLength <= 0 ||
+                static_cast<size_t>(messageLength) > kMaxMessageSize ||
+                size < static_cast<int>(sizeof(messageLength)))
             {
                 return message;
             }
@@ -225,19 +359,13 @@ namespace mrv
             memset(m_buffer.data(), 0, messageLength);
 
             // Receive the message into the pre-allocated buffer
-            len = 0;
-            while (len < messageLength)
+            len = receiveAll(m_buffer.data(), messageLength);
+            if (len < messageLength)
             {
-                size = m_socket.receiveBytes(
-                    m_buffer.data() + len, messageLength - len);
-                if (size <= 0)
-                {
-                    LOG_ERROR("message not complete");
-                    return message;
-                }
-                len += size;
+                LOG_ERROR("message not complete");
+                return message;
             }
-            message = nlohmann::json::from_bson(m_buffer);
+            message = decodeMessage(m_buffer);
         }
         catch (const Poco::Exception& ex)
         {
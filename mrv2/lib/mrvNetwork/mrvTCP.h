@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <functional>
 #include <list>
 #include <vector>
 #include <string>
@@ -31,6 +33,9 @@ namespace mrv
 
     std::string ipToHostname(const std::string& ip);
 
+    //! Whether queued messages of a command are merged with the next one.
+    bool isCoalescible(const std::string& command);
+
     class TCP
     {
 
@@ -73,12 +78,38 @@ namespace mrv
 
         inline size_t numReceive() const { return m_receive.size(); };
 
+        //! Set the function called on the main thread, through Fl::awake,
+        //! when messages are received.
+        static void setReceiveCallback(const std::function<void()>&);
+
     protected:
         virtual void sendMessages() = 0;
         virtual void receiveMessages() = 0;
 
+        //! Block until there are messages to send or the connection
+        //! stops.  Returns false once stopped.
+        bool waitForSend();
+
         Message receiveMessage();
 
+        //! Receive size bytes, waiting for them if the socket does not
+        //! block.  Returns the bytes received, fewer if the connection
+        //! failed.
+        int receiveAll(void* data, int size);
+
+        //! Wake up the main thread to parse the messages received.
+        static void notifyReceive();
+
+        /**
+         * Add a message to a send or receive queue, merging it with the
+         * last one queued when it supersedes it.  Messages that carry
+         * only the latest state (seek, pan and zoom, gain...) replace
+         * one of the same command, and stroke points are batched into
+         * a single "Add Shape Points" message.
+         */
+        static void queueMessage(
+            std::list< Message >& messages, const Message& message);
+
     protected:
 #ifdef MRV2_NETWORK
         Poco::Net::StreamSocket m_socket;
@@ -92,6 +123,7 @@ namespace mrv
 
         std::vector< std::thread* > m_threads;
         std::mutex m_sendMutex;
+        std::condition_variable m_sendCV;
         std::list< Message > m_send;
 
         static std::mutex m_receiveMutex;
@@ -7,8 +7,6 @@
 #include "mrvWidgets/mrvFunctional.h"
 #include "mrvWidgets/mrvHistogram.h"
 
-#include "mrvFl/mrvColorAreaInfo.h"
-
 #include "mrvGL/mrvGLViewport.h"
 
 #include "mrvPanels/mrvPanelsCallbacks.h"
@@ -117,9 +115,9 @@ namespace mrv
             g->resizable(g);
         }
 
-        void HistogramPanel::update(const area::Info& info)
+        void HistogramPanel::update(const scopes::HistogramData& data)
         {
-            _r->histogram->update(info);
+            _r->histogram->update(data);
         }
 
     } // namespace panel
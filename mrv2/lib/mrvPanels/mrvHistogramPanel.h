@@ -6,15 +6,10 @@
 
 #include "mrvPanelWidget.h"
 
-#include "mrvFl/mrvColorAreaInfo.h"
+#include "mrvCore/mrvScopes.h"
 
 namespace mrv
 {
-    namespace area
-    {
-        class Info;
-    }
-
     namespace panel
     {
         class HistogramPanel : public PanelWidget
@@ -25,7 +20,7 @@ namespace mrv
 
             void add_controls() override;
 
-            void update(const area::Info& info);
+            void update(const scopes::HistogramData& data);
 
         private:
             MRV2_PRIVATE();
@@ -4,10 +4,13 @@
 
 #include <thread>
 
+#include <tlCore/StringFormat.h>
+
 #include <FL/Fl_Input.H>
 #include <FL/Fl_Int_Input.H>
 #include <FL/Fl_Flex.H>
 
+#include "mrvWidgets/mrvBrowser.h"
 #include "mrvWidgets/mrvFunctional.h"
 #include "mrvWidgets/mrvInput.h"
 #include "mrvWidgets/mrvIntInput.h"
@@ -15,11 +18,13 @@
 
 #include "mrvFl/mrvIO.h"
 
+#include "mrvNetwork/mrvCommandInterpreter.h"
 #include "mrvNetwork/mrvParseHost.h"
 #include "mrvNetwork/mrvServer.h"
 #include "mrvNetwork/mrvClient.h"
 #include "mrvNetwork/mrvDummyClient.h"
 
+#include "mrvApp/mrvApp.h"
 #include "mrvApp/mrvSettingsObject.h"
 
 #include "mrvPanelsCallbacks.h"
@@ -47,6 +52,8 @@ namespace mrv
             Fl_Group* portGroup = nullptr;
             Fl_Int_Input* port = nullptr;
             PopupMenu* typeMenu = nullptr;
+            Browser* statistics = nullptr;
+            int statisticsWidths[5] = {0, 0, 0, 0, 0};
             Type type = Type::Client;
         };
 
@@ -233,6 +240,44 @@ namespace mrv
                     }
                 });
 
+            Y += 30;
+
+            // Statistics of the commands received, to see which ones
+            // dominate a session.
+            Fl_Box* statisticsBox = new Fl_Box(
+                g->x(), Y, g->w(), 20, _("Commands Received"));
+            statisticsBox->labelsize(12);
+            statisticsBox->align(FL_ALIGN_INSIDE | FL_ALIGN_LEFT);
+
+            Y += 20;
+
+            _r->statistics = new Browser(g->x(), Y, g->w(), 160);
+            _r->statisticsWidths[0] = g->w() * 2 / 5;
+            _r->statisticsWidths[1] = g->w() / 5;
+            _r->statisticsWidths[2] = g->w() / 5;
+            _r->statistics->column_widths(_r->statisticsWidths);
+            _r->statistics->column_char('\t');
+            _r->statistics->textsize(12);
+            _r->statistics->tooltip(
+                _("Commands received and the time spent on them.  "
+                  "Commands marked with * are merged while queued."));
+            updateStatistics();
+
+            Y += 165;
+
+            bW = new Widget<Fl_Button>(g->x(), Y, 60, 20, _("Refresh"));
+            bW->callback([=](auto t) { updateStatistics(); });
+
+            bW = new Widget<Fl_Button>(g->x() + 65, Y, 60, 20, _("Reset"));
+            bW->callback(
+                [=](auto t)
+                {
+                    auto interpreter = App::app->commandInterpreter();
+                    if (interpreter)
+                        interpreter->resetStatistics();
+                    updateStatistics();
+                });
+
             g->end();
 
             if (dynamic_cast< DummyClient* >(tcp) == nullptr)
@@ -255,6 +300,36 @@ namespace mrv
             _p->ui->uiMain->fill_menu(_p->ui->uiMenuBar);
         }
 
+        void NetworkPanel::updateStatistics()
+        {
+            Browser* b = _r->statistics;
+            b->clear();
+            const std::string header =
+                tl::string::Format("@b{0}\t@b{1}\t@b{2}\t@b{3}")
+                    .arg(_("Command"))
+                    .arg(_("Count"))
+                    .arg(_("Total ms"))
+                    .arg(_("Average ms"));
+            b->add(header.c_str());
+
+            auto interpreter = App::app->commandInterpreter();
+            if (!interpreter)
+                return;
+
+            for (const auto& s : interpreter->statistics())
+            {
+                const double total = s.time.count() * 1000.0;
+                const std::string line =
+                    tl::string::Format("{0}{1}\t{2}\t{3}\t{4}")
+                        .arg(s.command)
+                        .arg(s.coalescible ? " *" : "")
+                        .arg(static_cast<int>(s.count))
+                        .arg(total, 2)
+                        .arg(total / s.count, 3);
+                b->add(line.c_str());
+            }
+        }
+
         void NetworkPanel::shutdown()
         {
             tcp->stop();
@@ -26,6 +26,10 @@ namespace mrv
         private:
             void deactivate();
 
+            //! Fill the browser with the statistics of the commands
+            //! received.
+            void updateStatistics();
+
             MRV2_PRIVATE();
         };
 
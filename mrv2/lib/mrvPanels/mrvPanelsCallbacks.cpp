@@ -25,6 +25,7 @@ namespace mrv
         ImageInfoPanel* imageInfoPanel = nullptr;
         HistogramPanel* histogramPanel = nullptr;
         VectorscopePanel* vectorscopePanel = nullptr;
+        WaveformPanel* waveformPanel = nullptr;
         Stereo3DPanel* stereo3DPanel = nullptr;
         BackgroundPanel* backgroundPanel = nullptr;
 #ifdef MRV2_PYBIND11
@@ -128,6 +129,8 @@ namespace mrv
                 histogram_panel_cb(nullptr, ui);
             if (vectorscopePanel && vectorscopePanel->is_panel())
                 vectorscope_panel_cb(nullptr, ui);
+            if (waveformPanel && waveformPanel->is_panel())
+                waveform_panel_cb(nullptr, ui);
             if (stereo3DPanel && stereo3DPanel->is_panel())
                 stereo3D_panel_cb(nullptr, ui);
             if (backgroundPanel && backgroundPanel->is_panel())
@@ -177,6 +180,8 @@ namespace mrv
                 histogram_panel_cb(nullptr, ui);
             if (vectorscopePanel && !vectorscopePanel->is_panel())
                 vectorscope_panel_cb(nullptr, ui);
+            if (waveformPanel && !waveformPanel->is_panel())
+                waveform_panel_cb(nullptr, ui);
             if (stereo3DPanel && !stereo3DPanel->is_panel())
                 stereo3D_panel_cb(nullptr, ui);
             if (backgroundPanel && !backgroundPanel->is_panel())
@@ -470,6 +475,26 @@ namespace mrv
             ui->uiMain->fill_menu(ui->uiMenuBar);
         }
 
+        void waveform_panel_cb(Fl_Widget* w, ViewerUI* ui)
+        {
+            bool send = ui->uiPrefs->SendUI->value();
+            if (send)
+            {
+                tcp->pushMessage(
+                    "Waveform Panel", static_cast<bool>(!waveformPanel));
+            }
+
+            if (waveformPanel)
+            {
+                delete waveformPanel;
+                waveformPanel = nullptr;
+                ui->uiMain->fill_menu(ui->uiMenuBar);
+                return;
+            }
+            waveformPanel = new WaveformPanel(ui);
+            ui->uiMain->fill_menu(ui->uiMenuBar);
+        }
+
         void environment_map_panel_cb(Fl_Widget* w, ViewerUI* ui)
         {
             bool send = ui->uiPrefs->SendUI->value();
@@ -613,6 +638,8 @@ namespace mrv
                     "Histogram Panel", static_cast<bool>(histogramPanel));
                 tcp->pushMessage(
                     "Vectorscope Panel", static_cast<bool>(vectorscopePanel));
+                tcp->pushMessage(
+                    "Waveform Panel", static_cast<bool>(waveformPanel));
             }
         }
 
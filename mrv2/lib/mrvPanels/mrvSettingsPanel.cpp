@@ -423,7 +423,7 @@ namespace mrv
                     refresh_movie_cb(nullptr, p.ui);
                 });
 
-            bg = new Fl_Group(g->x(), 440, g->w(), 30);
+            bg = new Fl_Group(g->x(), 440, g->w(), 54);
             bg->box(FL_NO_BOX);
             bg->begin();
 
@@ -449,6 +449,29 @@ namespace mrv
                     refresh_movie_cb(nullptr, p.ui);
                 });
 
+            spW = new Widget<Spinner>(
+                g->x() + 160, 464, g->w() - 160, 20, _("Readback buffers"));
+            sp = spW;
+            sp->range(2, 8);
+            digits = settings->getValue<int>("Performance/ReadbackBuffers");
+            sp->value(digits);
+            sp->tooltip(
+                _("Number of buffers used to read back the selection for the "
+                  "scopes.  More buffers add latency but stall less while "
+                  "playing."));
+            spW->callback(
+                [=](auto o)
+                {
+                    TLRENDER_P();
+                    int buffers = static_cast<int>(o->value());
+                    settings->setValue("Performance/ReadbackBuffers", buffers);
+                    p.ui->uiView->setReadbackBuffers(buffers);
+                    p.ui->uiView->redraw();
+                    if (p.ui->uiSecondary)
+                        p.ui->uiSecondary->viewport()->setReadbackBuffers(
+                            buffers);
+                });
+
             bg->end();
 
             cg->end();
@@ -30,7 +30,6 @@ namespace mrv
         ThumbnailPanel::ThumbnailPanel(ViewerUI* ui) :
             PanelWidget(ui)
         {
-            Fl::add_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this); 
         }
 
         ThumbnailPanel::~ThumbnailPanel()
@@ -52,31 +51,10 @@ namespace mrv
                 if (i->second.future.valid() &&
                     i->second.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                 {
-                    if (auto image = i->second.future.get())
+                    if (auto pixels = i->second.future.get())
                     {
-                        if (image::PixelType::RGBA_U8 == image->getPixelType())
-                        {
-                            const int w = image->getWidth();
-                            const int h = image->getHeight();
-                            const int depth = 4;
-
-                            uint8_t* pixelData = new uint8_t[w * h * depth];
-
-                            auto rgbImage = new Fl_RGB_Image(
-                                pixelData, w, h, depth);
-                            rgbImage->alloc_array = true;
-
-                            uint8_t* d = pixelData;
-                            const uint8_t* s = image->getData();
-                            for (int y = 0; y < h; ++y)
-                            {
-                                memcpy(
-                                    d + (h - 1 - y) * w * 4, s + y * w * 4,
-                                    w * 4);
-                            }
-                            i->first->bind_image(rgbImage);
-                            i->first->redraw();
-                        }
+                        i->first->bind_image(new ThumbnailImage(pixels));
+                        i->first->redraw();
                     }
                     i = thumbnailRequests.erase(i);
                 }
@@ -85,8 +63,10 @@ namespace mrv
                     ++i;
                 }
             }
-            Fl::repeat_timeout(kTimeout, (Fl_Timeout_Handler)timerEvent_cb,
-                               this);
+            // Only poll while there are thumbnails to wait for.
+            if (!thumbnailRequests.empty())
+                Fl::repeat_timeout(
+                    kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
         }
 
         void ThumbnailPanel::_createThumbnail(
@@ -140,7 +120,7 @@ namespace mrv
                 if (it != thumbnailRequests.end())
                 {
                     const auto& request = it->second;
-                    thumbnailSystem->cancelRequests( { request.id } );
+                    ThumbnailCache::instance().cancelRequests({request.id});
                     thumbnailRequests.erase(it);
                 }
 
@@ -154,7 +134,13 @@ namespace mrv
                 options["Layer"] = string::Format("{0}").arg(layerId);
                 
                 thumbnailRequests[widget] =
-                    thumbnailSystem->getThumbnail(path, size.h, time, options);
+                    ThumbnailCache::instance().getThumbnail(
+                        thumbnailSystem, path, size.h, time, options);
+
+                if (!Fl::has_timeout(
+                        (Fl_Timeout_Handler)timerEvent_cb, this))
+                    Fl::add_timeout(
+                        kTimeout, (Fl_Timeout_Handler)timerEvent_cb, this);
             }
             catch (const std::exception& e)
             {
@@ -169,16 +155,13 @@ namespace mrv
 
         void ThumbnailPanel::_cancelRequests()
         {
-            const auto context = App::app->getContext();
-            auto thumbnailSystem = context->getSystem<ui::ThumbnailSystem>();
-                
             std::vector<uint64_t> ids;
             for (const auto& i : thumbnailRequests)
             {
                 const auto& request = i.second;
                 ids.push_back(request.id);
             }
-            thumbnailSystem->cancelRequests(ids);
+            ThumbnailCache::instance().cancelRequests(ids);
             thumbnailRequests.clear();
         }
 
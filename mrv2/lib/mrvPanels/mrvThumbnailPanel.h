@@ -9,10 +9,10 @@
 #include <tlCore/Time.h>
 #include <tlCore/Path.h>
 
-#include <tlUI/ThumbnailSystem.h>
-
 #include <tlTimelineUI/TimelineWidget.h>
 
+#include "mrvCore/mrvThumbnailCache.h"
+
 #include "mrvPanelWidget.h"
 
 class ViewerUI;
@@ -52,7 +52,7 @@ namespace mrv
             //! Whether to clear the cache for the thumbnails.
             bool _clearCache = false;
 
-            std::map<Fl_Widget*, ui::ThumbnailRequest> thumbnailRequests;
+            std::map<Fl_Widget*, ThumbnailRequest> thumbnailRequests;
         };
 
     } // namespace panel
@@ -4,10 +4,10 @@
 
 #include "FL/Fl_Choice.H"
 
+#include "mrvWidgets/mrvFunctional.h"
+#include "mrvWidgets/mrvHorSlider.h"
 #include "mrvWidgets/mrvVectorscope.h"
 
-#include "mrvFl/mrvColorAreaInfo.h"
-
 #include "mrvPanels/mrvPanelsCallbacks.h"
 #include "mrvPanels/mrvVectorscopePanel.h"
 
@@ -60,6 +60,36 @@ namespace mrv
             int W = g->w() - 3;
             int H = g->h();
 
+            Fl_Group* cg;
+            Fl_Box* b;
+            Fl_Choice* c;
+            HorSlider* s;
+
+            cg = new Fl_Group(X, Y, W, 20);
+            cg->begin();
+            b = new Fl_Box(X, Y, 120, 20, _("Type"));
+            auto cW = new Widget< Fl_Choice >(X + b->w(), Y, W - b->w(), 20);
+            c = cW;
+            c->add(_("Linear"));
+            c->add(_("Logarithmic"));
+            c->value(1);
+            cW->callback(
+                [=](auto o)
+                {
+                    Vectorscope::Type c = (Vectorscope::Type)o->value();
+                    _r->vectorscope->scale_type(c);
+                });
+            cg->end();
+
+            auto sV = new Widget< HorSlider >(X, Y, W, 20, _("Intensity"));
+            s = sV;
+            s->range(0.1, 10.0);
+            s->step(0.1);
+            s->default_value(1.0);
+            s->tooltip(_("Multiplies the density of the vectorscope."));
+            sV->callback([=](auto o)
+                         { _r->vectorscope->intensity(o->value()); });
+
             // Create a square vectorscope
             r.vectorscope = new Vectorscope(X, Y, 270, 270);
             r.vectorscope->main(p.ui);
@@ -67,9 +97,9 @@ namespace mrv
             g->resizable(g);
         }
 
-        void VectorscopePanel::update(const area::Info& info)
+        void VectorscopePanel::update(const scopes::VectorscopeData& data)
         {
-            _r->vectorscope->update(info);
+            _r->vectorscope->update(data);
         }
 
     } // namespace panel
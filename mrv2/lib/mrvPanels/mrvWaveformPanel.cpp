@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <FL/Fl.H>
+#include <FL/Fl_Check_Button.H>
+#include <FL/Fl_Choice.H>
+
+#include "mrvWidgets/mrvFunctional.h"
+#include "mrvWidgets/mrvHorSlider.h"
+#include "mrvWidgets/mrvWaveform.h"
+
+#include "mrvPanels/mrvPanelsCallbacks.h"
+#include "mrvPanels/mrvWaveformPanel.h"
+
+#include "mrViewer.h"
+
+namespace
+{
+    void waveform_ready_cb(void* d)
+    {
+        // The panel may have been closed while the waveform was being
+        // calculated.
+        if (mrv::panel::waveformPanel)
+            mrv::panel::waveformPanel->waveform_ready();
+    }
+} // namespace
+
+namespace mrv
+{
+    namespace panel
+    {
+        struct WaveformPanel::Private
+        {
+            Waveform* waveform = nullptr;
+
+            scopes::WaveformOptions options;
+            scopes::WaveformWorker worker;
+            scopes::WaveformData data;
+        };
+
+        WaveformPanel::WaveformPanel(ViewerUI* ui) :
+            _r(new Private),
+            PanelWidget(ui)
+        {
+            add_group("Waveform");
+
+            Fl_SVG_Image* svg = load_svg("Waveform.svg");
+            g->bind_image(svg);
+
+            g->callback(
+                [](Fl_Widget* w, void* d)
+                {
+                    ViewerUI* ui = static_cast< ViewerUI* >(d);
+                    delete waveformPanel;
+                    waveformPanel = nullptr;
+                    ui->uiMain->fill_menu(ui->uiMenuBar);
+                },
+                ui);
+        }
+
+        WaveformPanel::~WaveformPanel() {}
+
+        void WaveformPanel::add_controls()
+        {
+            TLRENDER_P();
+            MRV2_R();
+
+            Pack* pack = g->get_pack();
+            pack->spacing(5);
+
+            g->clear();
+            g->begin();
+
+            int X = g->x();
+            int Y = g->y();
+            int W = g->w() - 3;
+            int H = g->h();
+
+            Fl_Group* cg;
+            Fl_Box* b;
+            Fl_Choice* c;
+            Fl_Check_Button* cb;
+            HorSlider* s;
+
+            cg = new Fl_Group(X, Y, W, 20);
+            cg->begin();
+            b = new Fl_Box(X, Y, 120, 20, _("Mode"));
+            auto mW = new Widget< Fl_Choice >(X + b->w(), Y, W - b->w(), 20);
+            c = mW;
+            c->add(_("Luma"));
+            c->add(_("RGB Parade"));
+            c->value(r.options.parade);
+            mW->callback([=](auto o)
+                         { _r->options.parade = o->value() == 1; });
+            cg->end();
+
+            cg = new Fl_Group(X, Y, W, 20);
+            cg->begin();
+            b = new Fl_Box(X, Y, 120, 20, _("Type"));
+            auto cW = new Widget< Fl_Choice >(X + b->w(), Y, W - b->w(), 20);
+            c = cW;
+            c->add(_("Linear"));
+            c->add(_("Logarithmic"));
+            c->value(1);
+            cW->callback(
+                [=](auto o)
+                {
+                    Waveform::Type c = (Waveform::Type)o->value();
+                    _r->waveform->scale_type(c);
+                });
+            cg->end();
+
+            auto sV = new Widget< HorSlider >(X, Y, W, 20, _("Intensity"));
+            s = sV;
+            s->range(0.1, 10.0);
+            s->step(0.1);
+            s->default_value(1.0);
+            s->tooltip(_("Multiplies the density of the waveform."));
+            sV->callback([=](auto o) { _r->waveform->intensity(o->value()); });
+
+            cg = new Fl_Group(X, Y, W, 20);
+            cg->begin();
+            auto bW = new Widget< Fl_Check_Button >(
+                X + 120, Y, W - 120, 20, _("Decimate"));
+            cb = bW;
+            cb->labelsize(12);
+            cb->align(FL_ALIGN_LEFT);
+            cb->value(r.options.decimate);
+            cb->tooltip(_("Samples only some of the scanlines and pixels of "
+                          "big selections, to keep up with playback."));
+            bW->callback([=](auto o)
+                         { _r->options.decimate = o->value(); });
+            cg->end();
+
+            r.waveform = new Waveform(X, Y, W, 200);
+            r.waveform->main(p.ui);
+            r.waveform->update(r.data);
+
+            g->resizable(g);
+        }
+
+        void WaveformPanel::update(
+            const math::Box2i& box, const float* image,
+            const math::Size2i& size)
+        {
+            MRV2_R();
+
+            // If the previous waveform is not done yet, this frame is
+            // skipped.
+            r.worker.request(
+                box, image, size, r.options,
+                [] { Fl::awake(waveform_ready_cb, nullptr); });
+        }
+
+        void WaveformPanel::waveform_ready()
+        {
+            MRV2_R();
+            if (!r.worker.result(r.data))
+                return;
+            r.waveform->update(r.data);
+        }
+
+    } // namespace panel
+} // namespace mrv
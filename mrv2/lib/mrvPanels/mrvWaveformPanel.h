@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include "mrvPanelWidget.h"
+
+#include "mrvCore/mrvScopes.h"
+
+namespace mrv
+{
+    namespace panel
+    {
+        class WaveformPanel : public PanelWidget
+        {
+        public:
+            WaveformPanel(ViewerUI* ui);
+            ~WaveformPanel();
+
+            void add_controls() override;
+
+            //! Start calculating the waveform of the selection of the
+            //! mapped BGRA float buffer.  The waveform is calculated off
+            //! the FLTK thread and shown when done.
+            void update(
+                const math::Box2i& box, const float* image,
+                const math::Size2i& size);
+
+            //! Show the last waveform calculated.
+            void waveform_ready();
+
+        private:
+            MRV2_PRIVATE();
+        };
+
+    } // namespace panel
+} // namespace mrv
@@ -5,8 +5,6 @@
 #include <FL/Enumerations.H>
 #include <FL/fl_draw.H>
 
-#include <Imath/ImathFun.h>
-
 #include "mrvWidgets/mrvHistogram.h"
 
 #include "mrViewer.h"
@@ -18,9 +16,7 @@ namespace mrv
     Histogram::Histogram(int X, int Y, int W, int H, const char* L) :
         Fl_Box(X, Y, W, H, L),
         _channel(kRGB),
-        _histtype(kLog),
-        maxLumma(0),
-        maxColor(0)
+        _histtype(kLog)
     {
         tooltip(_("Mark an area in the image with SHIFT + the left mouse "
                   "button"));
@@ -29,71 +25,13 @@ namespace mrv
     void Histogram::draw()
     {
         fl_rectf(x(), y(), w(), h(), 0, 0, 0);
-        if (maxLumma > 0)
+        if (_data.maxLumma > 0)
             draw_pixels();
     }
 
-    void Histogram::count_pixel(const uint8_t* rgb) noexcept
-    {
-        uint8_t r = rgb[0];
-        uint8_t g = rgb[1];
-        uint8_t b = rgb[2];
-
-        ++red[r];
-        if (red[r] > maxColor)
-            maxColor = red[r];
-
-        ++green[g];
-        if (green[g] > maxColor)
-            maxColor = green[g];
-
-        ++blue[b];
-        if (blue[b] > maxColor)
-            maxColor = blue[b];
-
-        unsigned int lum = unsigned(r * 0.30f + g * 0.59f + b * 0.11f);
-        lumma[lum] += 1;
-        if (lumma[lum] > maxLumma)
-            maxLumma = lumma[lum];
-    }
-
-    void Histogram::update(const area::Info& info)
+    void Histogram::update(const scopes::HistogramData& data)
     {
-        Viewport* view = ui->uiView;
-        const auto& renderSize = view->getRenderSize();
-        const image::Color4f* image = view->image();
-
-        maxColor = maxLumma = 0;
-        memset(red, 0, sizeof(float) * 256);
-        memset(green, 0, sizeof(float) * 256);
-        memset(blue, 0, sizeof(float) * 256);
-        memset(lumma, 0, sizeof(float) * 256);
-
-        if (!image || !renderSize.isValid())
-        {
-            redraw();
-            return;
-        }
-
-        int xmin = info.box.min.x;
-        int ymin = info.box.min.y;
-        int xmax = info.box.max.x;
-        int ymax = info.box.max.y;
-
-        image::Color4f* pixel;
-        uint8_t rgb[3];
-        for (int Y = ymin; Y <= ymax; ++Y)
-        {
-            for (int X = xmin; X <= xmax; ++X)
-            {
-                const auto& pixel = image[X + Y * renderSize.w];
-                rgb[0] = (uint8_t)Imath::clamp(pixel.b * 255.0f, 0.f, 255.f);
-                rgb[1] = (uint8_t)Imath::clamp(pixel.g * 255.0f, 0.f, 255.f);
-                rgb[2] = (uint8_t)Imath::clamp(pixel.r * 255.0f, 0.f, 255.f);
-                count_pixel(rgb);
-            }
-        }
-
+        _data = data;
         redraw();
     }
 
@@ -125,16 +63,16 @@ namespace mrv
         switch (_histtype)
         {
         case kLog:
-            maxL = logf(1 + maxLumma);
-            maxC = logf(1 + maxColor);
+            maxL = logf(1 + _data.maxLumma);
+            maxC = logf(1 + _data.maxColor);
             break;
         case kSqrt:
-            maxL = sqrtf(1 + maxLumma);
-            maxC = sqrtf(1 + maxColor);
+            maxL = sqrtf(1 + _data.maxLumma);
+            maxC = sqrtf(1 + _data.maxColor);
             break;
         default:
-            maxL = maxLumma;
-            maxC = maxColor;
+            maxL = _data.maxLumma;
+            maxC = _data.maxColor;
             break;
         }
 
@@ -151,7 +89,7 @@ namespace mrv
             if (_channel == kLumma)
             {
                 fl_color(255, 255, 255);
-                v = histogram_scale(lumma[idx], maxL);
+                v = histogram_scale(_data.lumma[idx], maxL);
                 int Y = Y2 - int(H * v);
                 fl_line(X, Y, X, Y2);
             }
@@ -159,7 +97,7 @@ namespace mrv
             if (_channel == kRed || _channel == kRGB)
             {
                 fl_color(255, 0, 0);
-                v = histogram_scale(red[idx], maxC);
+                v = histogram_scale(_data.red[idx], maxC);
                 int Y = Y2 - int(H * v);
                 if (Y > maxY)
                     maxY = Y;
@@ -169,7 +107,7 @@ namespace mrv
             if (_channel == kGreen || _channel == kRGB)
             {
                 fl_color(0, 255, 0);
-                v = histogram_scale(green[idx], maxC);
+                v = histogram_scale(_data.green[idx], maxC);
                 int Y = Y2 - int(H * v);
                 if (Y > maxY)
                     maxY = Y;
@@ -179,7 +117,7 @@ namespace mrv
             if (_channel == kBlue || _channel == kRGB)
             {
                 fl_color(0, 0, 255);
-                v = histogram_scale(blue[idx], maxC);
+                v = histogram_scale(_data.blue[idx], maxC);
                 int Y = Y2 - int(H * v);
                 if (Y > maxY)
                     maxY = Y;
@@ -8,7 +8,7 @@
 
 #include <tlCore/Util.h>
 
-#include "mrvFl/mrvColorAreaInfo.h"
+#include "mrvCore/mrvScopes.h"
 
 class ViewerUI;
 
@@ -52,7 +52,7 @@ namespace mrv
 
         virtual void draw() override;
 
-        void update(const area::Info& info);
+        void update(const scopes::HistogramData& data);
 
         void main(ViewerUI* m) { ui = m; };
         ViewerUI* main() { return ui; };
@@ -60,21 +60,12 @@ namespace mrv
     protected:
         void draw_pixels() const noexcept;
 
-        void count_pixel(const uint8_t* rgb) noexcept;
-
         inline float histogram_scale(float val, float maxVal) const noexcept;
 
         Channel _channel;
         Type _histtype;
 
-        float maxLumma;
-        float lumma[256];
-
-        float maxColor;
-
-        float red[256];
-        float green[256];
-        float blue[256];
+        scopes::HistogramData _data;
 
         ViewerUI* ui;
     };
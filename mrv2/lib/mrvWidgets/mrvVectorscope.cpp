@@ -4,9 +4,9 @@
 
 #include <FL/Enumerations.H>
 #include <FL/fl_draw.H>
+#include <FL/Fl_RGB_Image.H>
 
-#include <Imath/ImathMatrix.h>
-#include <Imath/ImathVec.h>
+#include <cmath>
 
 #include <tlCore/Math.h>
 
@@ -15,14 +15,50 @@
 #include "mrViewer.h"
 #include "mrvCore/mrvI8N.h"
 
+namespace
+{
+    tl::image::Color4f hsv_to_rgb(const float h, const float s, const float v)
+    {
+        const float h6 = h * 6.F;
+        const int i = int(h6) % 6;
+        const float f = h6 - std::floor(h6);
+        const float p = v * (1.F - s);
+        const float q = v * (1.F - s * f);
+        const float t = v * (1.F - s * (1.F - f));
+        switch (i)
+        {
+        case 0:
+            return tl::image::Color4f(v, t, p);
+        case 1:
+            return tl::image::Color4f(q, v, p);
+        case 2:
+            return tl::image::Color4f(p, v, t);
+        case 3:
+            return tl::image::Color4f(p, q, v);
+        case 4:
+            return tl::image::Color4f(t, p, v);
+        default:
+            return tl::image::Color4f(v, p, q);
+        }
+    }
+} // namespace
+
 namespace mrv
 {
     struct Vectorscope::Private
     {
         int diameter;
-        math::Size2i renderSize;
-        math::Box2i box;
-        image::Color4f* image = nullptr;
+        scopes::VectorscopeData data;
+        Type type = kLog;
+        float intensity = 1.F;
+
+        //! Fully saturated color of each cell of the density grid.
+        std::vector<uint8_t> cellColors;
+
+        //! RGB density image and the FLTK image that wraps it.
+        std::vector<uint8_t> pixels;
+        Fl_RGB_Image* image = nullptr;
+
         ViewerUI* ui;
     };
 
@@ -30,11 +66,46 @@ namespace mrv
         Fl_Group(X, Y, W, H, L),
         _p(new Private)
     {
+        TLRENDER_P();
+
+        using namespace scopes;
+
         tooltip(_("Mark an area in the image with SHIFT + the left mouse "
                   "button"));
+
+        // Precompute the color of each cell from its hue and saturation.
+        p.cellColors.resize(kVectorscopeSize * kVectorscopeSize * 3);
+        uint8_t* color = p.cellColors.data();
+        for (int cy = 0; cy < kVectorscopeSize; ++cy)
+        {
+            for (int cx = 0; cx < kVectorscopeSize; ++cx, color += 3)
+            {
+                const float X = (cx + 0.5F) / kVectorscopeSize - 0.5F;
+                const float Y = (cy + 0.5F) / kVectorscopeSize - 0.5F;
+                float s = std::sqrt(X * X + Y * Y) / 0.375F;
+                if (s > 1.F)
+                    s = 1.F;
+                float h = (math::rad2deg(std::atan2(X, Y)) - 15.F) / 360.F;
+                h -= std::floor(h);
+
+                // Hue was taken from BGRA as RGB, so we swap R and B.
+                const image::Color4f c = hsv_to_rgb(h, s, 1.F);
+                color[0] = uint8_t(c.b * 255.F);
+                color[1] = uint8_t(c.g * 255.F);
+                color[2] = uint8_t(c.r * 255.F);
+            }
+        }
+
+        p.pixels.resize(p.cellColors.size(), 0);
+        p.image = new Fl_RGB_Image(
+            p.pixels.data(), kVectorscopeSize, kVectorscopeSize, 3);
     }
 
-    Vectorscope::~Vectorscope() {}
+    Vectorscope::~Vectorscope()
+    {
+        TLRENDER_P();
+        delete p.image;
+    }
 
     void Vectorscope::main(ViewerUI* m)
     {
@@ -46,6 +117,30 @@ namespace mrv
         return _p->ui;
     }
 
+    void Vectorscope::scale_type(Type t)
+    {
+        _p->type = t;
+        update_image();
+        redraw();
+    }
+
+    Vectorscope::Type Vectorscope::scale_type() const
+    {
+        return _p->type;
+    }
+
+    void Vectorscope::intensity(float v)
+    {
+        _p->intensity = v;
+        update_image();
+        redraw();
+    }
+
+    float Vectorscope::intensity() const
+    {
+        return _p->intensity;
+    }
+
     void Vectorscope::draw()
     {
         TLRENDER_P();
@@ -55,133 +150,66 @@ namespace mrv
         if (w() < p.diameter)
             p.diameter = w();
 
-        draw_grid();
-        if (p.image)
+        if (p.data.maxDensity > 0)
         {
             draw_pixels();
         }
+        draw_grid();
     }
 
-    void Vectorscope::update(const area::Info& info)
+    void Vectorscope::update(const scopes::VectorscopeData& data)
     {
         TLRENDER_P();
-
-        Viewport* view = p.ui->uiView;
-        const auto& newRenderSize = view->getRenderSize();
-        const image::Color4f* viewImage = view->image();
-        p.box = info.box;
-
-        if (!viewImage || !newRenderSize.isValid())
-        {
-            redraw();
-            return;
-        }
-
-        const size_t dataSize =
-            newRenderSize.w * newRenderSize.h * sizeof(image::Color4f);
-        if (newRenderSize != p.renderSize)
-        {
-            p.renderSize = newRenderSize;
-            free(p.image);
-            p.image = (image::Color4f*)malloc(dataSize);
-        }
-        memcpy(p.image, viewImage, dataSize);
-
+        p.data = data;
+        update_image();
         redraw();
     }
 
-    void Vectorscope::draw_pixel(image::Color4f& color) const noexcept
+    void Vectorscope::update_image() noexcept
     {
         TLRENDER_P();
 
-        using namespace Imath;
-
-        if (color.r < 0)
-            color.r = 0;
-        if (color.g < 0)
-            color.g = 0;
-        if (color.b < 0)
-            color.b = 0;
-
-        if (color.r > 1.F)
-            color.r = 1.F;
-        if (color.g > 1.F)
-            color.g = 1.F;
-        if (color.b > 1.F)
-            color.b = 1.F;
-
-        // We swap R and B channels
-        uint8_t r = color.b * 255.F;
-        uint8_t g = color.g * 255.F;
-        uint8_t b = color.r * 255.F;
-
-        image::Color4f hsv = color::rgb::to_hsv(color);
-
-        int W = p.diameter / 2;
-        int H = p.diameter / 2;
-
-#ifdef __linux__
-        M44f m;
-
-        // Translate to center
-        m.translate(V3f(x() + W, y() + H, 0));
-
-        // Rotate base on hue
-        m.rotate(V3f(0, 0, math::deg2rad(-15.0 - hsv.r * 360.0f)));
-
-        // Scale based on saturation
-        float s = hsv.g * 0.375f;
-        m.scale(V3f(s, s, 1));
+        using namespace scopes;
 
-        V3f pos(0, p.diameter, 0);
-
-        pos = pos * m;
-
-        fl_rectf(pos.x, pos.y, 1, 1, r, g, b);
-#else
-        fl_push_matrix();
-
-        // Position at center of circle
-        fl_translate(x() + W, y() + H);
+        if (p.data.density.empty() || p.data.maxDensity == 0)
+            return;
 
-        // Rotate base on hue
-        fl_rotate(15.0 + hsv.r * 360.0f);
+        const float maxV = p.type == kLog ? logf(1.F + p.data.maxDensity)
+                                          : float(p.data.maxDensity);
 
-        // Scale based on saturation
-        float s = hsv.g * 0.375f;
-        fl_scale(s, s);
+        const uint32_t* density = p.data.density.data();
+        const uint8_t* color = p.cellColors.data();
+        uint8_t* pixel = p.pixels.data();
+        const size_t numCells = kVectorscopeSize * kVectorscopeSize;
+        for (size_t i = 0; i < numCells; ++i, color += 3, pixel += 3)
+        {
+            const uint32_t d = density[i];
+            if (d == 0)
+            {
+                pixel[0] = pixel[1] = pixel[2] = 0;
+                continue;
+            }
 
-        fl_color(r, g, b);
-        fl_begin_points();
-        fl_vertex(0, p.diameter);
-        fl_end_points();
+            float v = p.type == kLog ? logf(1.F + d) : float(d);
+            v = v / maxV * p.intensity;
+            if (v > 1.F)
+                v = 1.F;
+            pixel[0] = uint8_t(color[0] * v);
+            pixel[1] = uint8_t(color[1] * v);
+            pixel[2] = uint8_t(color[2] * v);
+        }
 
-        fl_pop_matrix();
-#endif
+        p.image->uncache();
     }
 
     void Vectorscope::draw_pixels() const noexcept
     {
         TLRENDER_P();
 
-        if (!p.box.isValid())
-            return;
-
-        int stepX = (p.box.max.x - p.box.min.x) / p.diameter;
-        int stepY = (p.box.max.y - p.box.min.y) / p.diameter;
-        if (stepX < 1)
-            stepX = 1;
-        if (stepY < 1)
-            stepY = 1;
-
-        for (int Y = p.box.min.y; Y < p.box.max.y; Y += stepY)
-        {
-            for (int X = p.box.min.x; X < p.box.max.x; X += stepX)
-            {
-                image::Color4f& color = p.image[X + Y * p.renderSize.w];
-                draw_pixel(color);
-            }
-        }
+        // The density image is drawn scaled to the vectorscope circle, so
+        // the cost of drawing does not depend on the selection size.
+        p.image->scale(p.diameter, p.diameter, 0, 1);
+        p.image->draw(x(), y());
     }
 
     void Vectorscope::draw_grid() noexcept
@@ -10,7 +10,7 @@
 #include <tlCore/Color.h>
 #include <tlCore/Image.h>
 
-#include "mrvFl/mrvColorAreaInfo.h"
+#include "mrvCore/mrvScopes.h"
 
 class ViewerUI;
 
@@ -20,21 +20,35 @@ namespace mrv
 
     class Vectorscope : public Fl_Group
     {
+    public:
+        enum Type {
+            kLinear,
+            kLog,
+        };
+
     public:
         Vectorscope(int X, int Y, int W, int H, const char* L = 0);
         ~Vectorscope();
 
+        //! Scaling of the density of each hue/saturation.
+        void scale_type(Type t);
+        Type scale_type() const;
+
+        //! Intensity multiplier of the density.
+        void intensity(float v);
+        float intensity() const;
+
         virtual void draw() override;
 
-        void update(const area::Info& info);
+        void update(const scopes::VectorscopeData& data);
 
         void main(ViewerUI* m);
         ViewerUI* main();
 
     protected:
         void draw_grid() noexcept;
-        void draw_pixel(image::Color4f& rgb) const noexcept;
         void draw_pixels() const noexcept;
+        void update_image() noexcept;
 
         TLRENDER_PRIVATE();
     };
@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include <FL/Enumerations.H>
+#include <FL/fl_draw.H>
+#include <FL/Fl_RGB_Image.H>
+
+#include <cmath>
+#include <string>
+
+#include "mrvWidgets/mrvWaveform.h"
+
+#include "mrViewer.h"
+#include "mrvCore/mrvI8N.h"
+
+namespace mrv
+{
+    struct Waveform::Private
+    {
+        scopes::WaveformData data;
+        Type type = kLog;
+        float intensity = 1.F;
+
+        //! RGB density image and the FLTK image that wraps it.
+        std::vector<uint8_t> pixels;
+        Fl_RGB_Image* image = nullptr;
+
+        ViewerUI* ui;
+    };
+
+    Waveform::Waveform(int X, int Y, int W, int H, const char* L) :
+        Fl_Group(X, Y, W, H, L),
+        _p(new Private)
+    {
+        tooltip(_("Mark an area in the image with SHIFT + the left mouse "
+                  "button"));
+    }
+
+    Waveform::~Waveform()
+    {
+        TLRENDER_P();
+        delete p.image;
+    }
+
+    void Waveform::main(ViewerUI* m)
+    {
+        _p->ui = m;
+    }
+
+    ViewerUI* Waveform::main()
+    {
+        return _p->ui;
+    }
+
+    void Waveform::scale_type(Type t)
+    {
+        _p->type = t;
+        update_image();
+        redraw();
+    }
+
+    Waveform::Type Waveform::scale_type() const
+    {
+        return _p->type;
+    }
+
+    void Waveform::intensity(float v)
+    {
+        _p->intensity = v;
+        update_image();
+        redraw();
+    }
+
+    float Waveform::intensity() const
+    {
+        return _p->intensity;
+    }
+
+    void Waveform::draw()
+    {
+        TLRENDER_P();
+        fl_rectf(x(), y(), w(), h(), 0, 0, 0);
+
+        if (p.image && p.data.maxDensity > 0)
+        {
+            // The density image is drawn scaled to the widget, so the
+            // cost of drawing does not depend on the selection size.
+            p.image->scale(w(), h(), 0, 1);
+            p.image->draw(x(), y());
+        }
+        draw_grid();
+    }
+
+    void Waveform::update(const scopes::WaveformData& data)
+    {
+        TLRENDER_P();
+        p.data = data;
+        update_image();
+        redraw();
+    }
+
+    void Waveform::update_image() noexcept
+    {
+        TLRENDER_P();
+
+        using namespace scopes;
+
+        const int columns = p.data.columns;
+        if (columns <= 0 || p.data.maxDensity == 0)
+            return;
+
+        // The RGB parade places the red, green and blue waveforms side by
+        // side.
+        const int numParts = p.data.parade ? 3 : 1;
+        const int W = columns * numParts;
+        const int H = kWaveformLevels;
+        if (!p.image || p.image->data_w() != W || p.image->data_h() != H)
+        {
+            delete p.image;
+            p.pixels.resize(static_cast<size_t>(W) * H * 3);
+            p.image = new Fl_RGB_Image(p.pixels.data(), W, H, 3);
+        }
+
+        const float maxV = p.type == kLog ? logf(1.F + p.data.maxDensity)
+                                          : float(p.data.maxDensity);
+
+        static const uint8_t kLumaColor[3] = {255, 255, 255};
+        static const uint8_t kParadeColors[3][3] = {
+            {255, 0, 0}, {0, 255, 0}, {0, 0, 255}};
+
+        const std::vector<uint32_t>* parts[3] = {
+            &p.data.red, &p.data.green, &p.data.blue};
+        if (!p.data.parade)
+            parts[0] = &p.data.luma;
+
+        for (int part = 0; part < numParts; ++part)
+        {
+            const uint32_t* density = parts[part]->data();
+            const uint8_t* color =
+                p.data.parade ? kParadeColors[part] : kLumaColor;
+            for (int level = 0; level < H; ++level)
+            {
+                // Level 0 is at the bottom of the image.
+                uint8_t* pixel = p.pixels.data() +
+                                 (static_cast<size_t>(H - 1 - level) * W +
+                                  part * columns) *
+                                     3;
+                const uint32_t* row =
+                    density + static_cast<size_t>(level) * columns;
+                for (int c = 0; c < columns; ++c, pixel += 3)
+                {
+                    const uint32_t d = row[c];
+                    if (d == 0)
+                    {
+                        pixel[0] = pixel[1] = pixel[2] = 0;
+                        continue;
+                    }
+
+                    float v = p.type == kLog ? logf(1.F + d) : float(d);
+                    v = v / maxV * p.intensity;
+                    if (v > 1.F)
+                        v = 1.F;
+                    pixel[0] = uint8_t(color[0] * v);
+                    pixel[1] = uint8_t(color[1] * v);
+                    pixel[2] = uint8_t(color[2] * v);
+                }
+            }
+        }
+
+        p.image->uncache();
+    }
+
+    void Waveform::draw_grid() noexcept
+    {
+        TLRENDER_P();
+
+        fl_line_style(FL_DOT);
+        fl_font(FL_HELVETICA, 10);
+
+        // Horizontal lines every 25% of the signal.
+        for (int i = 0; i <= 4; ++i)
+        {
+            const int Y = y() + h() - 1 - (h() - 1) * i / 4;
+            fl_color(96, 96, 96);
+            fl_line(x(), Y, x() + w() - 1, Y);
+
+            const std::string label = std::to_string(i * 25);
+            fl_color(255, 255, 0);
+            fl_draw(label.c_str(), x() + 2, i == 4 ? Y + 10 : Y - 2);
+        }
+
+        // Separators of the RGB parade.
+        if (p.data.parade)
+        {
+            fl_color(160, 160, 160);
+            for (int i = 1; i < 3; ++i)
+            {
+                const int X = x() + w() * i / 3;
+                fl_line(X, y(), X, y() + h() - 1);
+            }
+        }
+
+        fl_line_style(0);
+    }
+
+} // namespace mrv
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <FL/Fl_Group.H>
+
+#include <tlCore/Util.h>
+
+#include "mrvCore/mrvScopes.h"
+
+class ViewerUI;
+
+namespace mrv
+{
+    using namespace tl;
+
+    class Waveform : public Fl_Group
+    {
+    public:
+        enum Type {
+            kLinear,
+            kLog,
+        };
+
+    public:
+        Waveform(int X, int Y, int W, int H, const char* L = 0);
+        ~Waveform();
+
+        //! Scaling of the density of each level.
+        void scale_type(Type t);
+        Type scale_type() const;
+
+        //! Intensity multiplier of the density.
+        void intensity(float v);
+        float intensity() const;
+
+        virtual void draw() override;
+
+        void update(const scopes::WaveformData& data);
+
+        void main(ViewerUI* m);
+        ViewerUI* main();
+
+    protected:
+        void draw_grid() noexcept;
+        void update_image() noexcept;
+
+        TLRENDER_PRIVATE();
+    };
+
+} // namespace mrv